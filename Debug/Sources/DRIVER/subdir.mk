@@ -5,6 +5,7 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
 ../Sources/DRIVER/DRIVER_GPIO.c \
+../Sources/DRIVER/DRIVER_MCG.c \
 ../Sources/DRIVER/DRIVER_NVIC.c \
 ../Sources/DRIVER/DRIVER_PORT.c \
 ../Sources/DRIVER/DRIVER_SIM.c \
@@ -12,6 +13,7 @@ C_SRCS += \
 
 OBJS += \
 ./Sources/DRIVER/DRIVER_GPIO.o \
+./Sources/DRIVER/DRIVER_MCG.o \
 ./Sources/DRIVER/DRIVER_NVIC.o \
 ./Sources/DRIVER/DRIVER_PORT.o \
 ./Sources/DRIVER/DRIVER_SIM.o \
@@ -19,6 +21,7 @@ OBJS += \
 
 C_DEPS += \
 ./Sources/DRIVER/DRIVER_GPIO.d \
+./Sources/DRIVER/DRIVER_MCG.d \
 ./Sources/DRIVER/DRIVER_NVIC.d \
 ./Sources/DRIVER/DRIVER_PORT.d \
 ./Sources/DRIVER/DRIVER_SIM.d \
@@ -29,7 +32,7 @@ C_DEPS += \
 Sources/DRIVER/%.o: ../Sources/DRIVER/%.c
 	@echo 'Building file: $<'
 	@echo 'Invoking: Cross ARM C Compiler'
-	arm-none-eabi-gcc -mcpu=cortex-m0plus -mthumb -O0 -fmessage-length=0 -fsigned-char -ffunction-sections -fdata-sections  -g3 -I"../Sources" -I"../Includes" -std=c99 -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	arm-none-eabi-gcc -mcpu=cortex-m0plus -mthumb -Os -fmessage-length=0 -fsigned-char -ffunction-sections -fdata-sections  -g3 -I"../Sources" -I"../Includes" -std=c99 $(BOOT_DEFINES) -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
@@ -5,6 +5,7 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
 ../Sources/HAL/HAL_GPIO.c \
+../Sources/HAL/HAL_MCG.c \
 ../Sources/HAL/HAL_NVIC.c \
 ../Sources/HAL/HAL_PORT.c \
 ../Sources/HAL/HAL_SIM.c \
@@ -12,6 +13,7 @@ C_SRCS += \
 
 OBJS += \
 ./Sources/HAL/HAL_GPIO.o \
+./Sources/HAL/HAL_MCG.o \
 ./Sources/HAL/HAL_NVIC.o \
 ./Sources/HAL/HAL_PORT.o \
 ./Sources/HAL/HAL_SIM.o \
@@ -19,6 +21,7 @@ OBJS += \
 
 C_DEPS += \
 ./Sources/HAL/HAL_GPIO.d \
+./Sources/HAL/HAL_MCG.d \
 ./Sources/HAL/HAL_NVIC.d \
 ./Sources/HAL/HAL_PORT.d \
 ./Sources/HAL/HAL_SIM.d \
@@ -29,7 +32,7 @@ C_DEPS += \
 Sources/HAL/%.o: ../Sources/HAL/%.c
 	@echo 'Building file: $<'
 	@echo 'Invoking: Cross ARM C Compiler'
-	arm-none-eabi-gcc -mcpu=cortex-m0plus -mthumb -O0 -fmessage-length=0 -fsigned-char -ffunction-sections -fdata-sections  -g3 -I"../Sources" -I"../Includes" -std=c99 -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	arm-none-eabi-gcc -mcpu=cortex-m0plus -mthumb -Os -fmessage-length=0 -fsigned-char -ffunction-sections -fdata-sections  -g3 -I"../Sources" -I"../Includes" -std=c99 $(BOOT_DEFINES) -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
@@ -4,24 +4,63 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
+../Sources/AES128.c \
 ../Sources/BOOT.c \
+../Sources/CRC16.c \
+../Sources/CRC32.c \
+../Sources/ECDSA.c \
 ../Sources/FLASH.c \
+../Sources/FRAME.c \
+../Sources/IMAGE.c \
+../Sources/JOURNAL.c \
+../Sources/LZ4.c \
+../Sources/PATCH.c \
 ../Sources/QUEUE.c \
+../Sources/SHA256.c \
+../Sources/SLOT.c \
 ../Sources/SREC.c \
+../Sources/TIMESTAMP.c \
+../Sources/YMODEM.c \
 ../Sources/main.c 
 
 OBJS += \
+./Sources/AES128.o \
 ./Sources/BOOT.o \
+./Sources/CRC16.o \
+./Sources/CRC32.o \
+./Sources/ECDSA.o \
 ./Sources/FLASH.o \
+./Sources/FRAME.o \
+./Sources/IMAGE.o \
+./Sources/JOURNAL.o \
+./Sources/LZ4.o \
+./Sources/PATCH.o \
 ./Sources/QUEUE.o \
+./Sources/SHA256.o \
+./Sources/SLOT.o \
 ./Sources/SREC.o \
+./Sources/TIMESTAMP.o \
+./Sources/YMODEM.o \
 ./Sources/main.o 
 
 C_DEPS += \
+./Sources/AES128.d \
 ./Sources/BOOT.d \
+./Sources/CRC16.d \
+./Sources/CRC32.d \
+./Sources/ECDSA.d \
 ./Sources/FLASH.d \
+./Sources/FRAME.d \
+./Sources/IMAGE.d \
+./Sources/JOURNAL.d \
+./Sources/LZ4.d \
+./Sources/PATCH.d \
 ./Sources/QUEUE.d \
+./Sources/SHA256.d \
+./Sources/SLOT.d \
 ./Sources/SREC.d \
+./Sources/TIMESTAMP.d \
+./Sources/YMODEM.d \
 ./Sources/main.d 
 
 
@@ -29,7 +68,7 @@ C_DEPS += \
 Sources/%.o: ../Sources/%.c
 	@echo 'Building file: $<'
 	@echo 'Invoking: Cross ARM C Compiler'
-	arm-none-eabi-gcc -mcpu=cortex-m0plus -mthumb -O0 -fmessage-length=0 -fsigned-char -ffunction-sections -fdata-sections  -g3 -I"../Sources" -I"../Includes" -std=c99 -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	arm-none-eabi-gcc -mcpu=cortex-m0plus -mthumb -Os -fmessage-length=0 -fsigned-char -ffunction-sections -fdata-sections  -g3 -I"../Sources" -I"../Includes" -std=c99 $(BOOT_DEFINES) -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
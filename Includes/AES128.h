@@ -0,0 +1,87 @@
+/**
+ * @file AES128.h
+ * @brief Header file for the AES-128 block cipher.
+ * @details This header file declares the AES-128 encryption and the CTR key stream that decrypts encrypted images.
+ *          CTR mode only needs the forward cipher, so no decryption rounds are provided.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+#ifndef INCLUDES_AES128_H_
+#define INCLUDES_AES128_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "MKL46Z4.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define AES128_KEY_SIZE 16u   /* Key length in bytes */
+#define AES128_BLOCK_SIZE 16u /* Block length in bytes */
+#define AES128_ROUNDS 10u     /* Number of rounds */
+
+/*
+ *@brief Expanded AES-128 key.
+ */
+typedef struct AES128_Context
+{
+    uint32_t Round_Key[4u * (AES128_ROUNDS + 1u)]; /**< Round keys, big-endian words */
+} AES128_Context;
+
+/*
+ *@brief AES-128-CTR key stream, addressed by byte offset.
+ */
+typedef struct AES128_CTR_Context
+{
+    AES128_Context Cipher;                      /**< Expanded key */
+    uint8_t Initial_Counter[AES128_BLOCK_SIZE]; /**< Counter block of offset 0 */
+    uint8_t Key_Stream[AES128_BLOCK_SIZE];      /**< Key stream block Key_Stream_Index */
+    uint32_t Key_Stream_Index;                  /**< Offset / 16 of Key_Stream */
+} AES128_CTR_Context;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief Expands an AES-128 key.
+ *@param Context Pointer to the context receiving the round keys.
+ *@param Key Pointer to the AES128_KEY_SIZE byte key.
+ */
+void AES128_Init(AES128_Context *Context, const uint8_t *Key);
+
+/*
+ *@brief Encrypts one block.
+ *@param Context Pointer to the expanded key.
+ *@param Input Pointer to the AES128_BLOCK_SIZE byte plaintext.
+ *@param Output Pointer to the AES128_BLOCK_SIZE byte ciphertext; may be the same as Input.
+ */
+void AES128_Encrypt_Block(const AES128_Context *Context, const uint8_t *Input, uint8_t *Output);
+
+/*
+ *@brief Starts a CTR key stream.
+ *@details The key stream block of offset o is AES(Initial_Counter + o / 16), the counter being a 128-bit big-endian
+ *         number, so data can be processed in any order.
+ *@param Context Pointer to the context to initialize.
+ *@param Key Pointer to the AES128_KEY_SIZE byte key.
+ *@param Initial_Counter Pointer to the AES128_BLOCK_SIZE byte counter of offset 0.
+ */
+void AES128_CTR_Init(AES128_CTR_Context *Context, const uint8_t *Key, const uint8_t *Initial_Counter);
+
+/*
+ *@brief Encrypts or decrypts data in place with the key stream.
+ *@param Context Pointer to the started key stream.
+ *@param Offset Offset of the data in the stream.
+ *@param Data Pointer to the data.
+ *@param Length Number of bytes.
+ */
+void AES128_CTR_Crypt(AES128_CTR_Context *Context, uint32_t Offset, uint8_t *Data, uint32_t Length);
+
+#endif /* INCLUDES_AES128_H_ */
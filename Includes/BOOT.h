@@ -1,9 +1,28 @@
 /**
  * @file BOOT.h
  * @brief Header file for the bootloader functions.
- * @details This header file contains the declaration for the `JumpToApplication` function. It provides
+ * @details This header file contains the declarations for the `Check_Application_Image` and `JumpToApplication` functions. It provides
  *          the necessary interface for transitioning control from the bootloader to the main application.
  *          This file ensures that the bootloader can properly execute the application code located at a predefined address.
+ *
+ *          The application enters update mode without SW2 by writing BOOT_UPDATE_REQUEST_MAGIC at
+ *          BOOT_UPDATE_REQUEST_ADDRESS and calling NVIC_SystemReset(). The word lies in RAM the linker script keeps out
+ *          of the bootloader's .data and .bss init (m_noinit), so it survives the reset. The rest of m_noinit holds
+ *          the boot timestamps (see TIMESTAMP.h).
+ *
+ *          Without a request, the bootloader listens on UART0 for a sync pattern during a short window before it
+ *          starts the application. The window length, in ms, is the word at BOOT_CONFIG_ADDRESS: erased, it is
+ *          BOOT_SYNC_WINDOW_DEFAULT_MS. Production programs a longer window; field units program 0, which needs no
+ *          erase since it only clears bits, and boot without waiting. Only a window of 0 lets Reset_Handler start
+ *          the application before the C runtime init: a unit with the erased word always boots through main().
+ *
+ *          BOOTLOADER_END is the only definition of the flash layout: the boot configuration, boot log, slot
+ *          metadata, journal and header sectors follow it, then the application. Its value comes from the build
+ *          (makefile.init), which also passes it to the linker script as __bootloader_end; the link fails if the
+ *          bootloader code and .data initializers reach it.
+ *
+ *          The update formats beyond plain and framed S-records are optional (BOOT_FEATURE_*). make BOOT_MINIMAL=1
+ *          leaves all of them out and moves BOOTLOADER_END down from 0x8400 to 0x4800.
  * @author  Nguyen Dang Nhu Tri
  * @version 1.0
  * @date 2024/07/19
@@ -20,7 +39,75 @@
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
-#define APPLICATION_ADDRESS 0x0000A000 /* APPLICATION ADDRESS */
+/*
+ *@brief Optional parts of the update path, 0 to leave them out of the build.
+ *@details Their code is only referenced under these switches, so --gc-sections drops the modules left out. An update
+ *         using a format left out is refused.
+ */
+#ifndef BOOT_FEATURE_SIGNATURE
+#define BOOT_FEATURE_SIGNATURE 1       /* SHA-256 digest and ECDSA P-256 signature records (SHA256, ECDSA) */
+#endif
+#ifndef BOOT_FEATURE_ENCRYPTION
+#define BOOT_FEATURE_ENCRYPTION 1      /* AES-128-CTR encrypted images (AES128) */
+#endif
+#ifndef BOOT_FEATURE_LZ4
+#define BOOT_FEATURE_LZ4 1             /* LZ4 compressed images (LZ4) */
+#endif
+#ifndef BOOT_FEATURE_PATCH
+#define BOOT_FEATURE_PATCH 1           /* Delta patches against the installed image (PATCH) */
+#endif
+#ifndef BOOT_FEATURE_YMODEM
+#define BOOT_FEATURE_YMODEM 1          /* XMODEM-1K and YMODEM transfers (YMODEM) */
+#endif
+#define BOOT_FEATURE_STREAM (BOOT_FEATURE_LZ4 || BOOT_FEATURE_PATCH || BOOT_FEATURE_YMODEM) /* Raw UART0 bytes buffered */
+
+/*
+ *@brief End of the bootloader (exclusive), defined by the build with the same value as __bootloader_end.
+ */
+#ifndef BOOTLOADER_END
+#error "BOOTLOADER_END is defined by the build, see makefile.init"
+#endif
+
+#define APPLICATION_ADDRESS (BOOTLOADER_END + 0x1C00) /* Above the boot configuration, boot log, slot metadata, journal and header sectors */
+#define FLASH_END_ADDRESS 0x00040000   /* End of the 256 KB program flash (exclusive) */
+#define RAM_START_ADDRESS 0x1FFFE000   /* Start of SRAM_L */
+#define RAM_END_ADDRESS 0x20006000     /* End of SRAM_U (exclusive) */
+#define BOOT_NOINIT_ADDRESS RAM_START_ADDRESS         /* m_noinit in the linker script, not touched by the C runtime init */
+#define BOOT_NOINIT_SIZE 0x100u                       /* Length of m_noinit */
+#define BOOT_UPDATE_REQUEST_ADDRESS BOOT_NOINIT_ADDRESS /* Update request word, written by the application */
+#define BOOT_UPDATE_REQUEST_MAGIC 0x51455255u         /* "UREQ" in memory: enter update mode after the reset */
+#define BOOT_CONFIG_ADDRESS BOOTLOADER_END            /* Boot configuration sector, below the boot log (see IMAGE.h) */
+#define BOOT_CONFIG_ERASED 0xFFFFFFFFu                /* Configuration word never programmed */
+#define BOOT_SYNC_WINDOW_MAX_MS 10000u                /* Longest window, a corrupted word does not stall the boot */
+
+/*
+ *@brief Sync window, in ms, while the configuration word is erased.
+ *@details Any non-zero window, this one included, disables the fast path of Reset_Handler.
+ */
+#ifndef BOOT_SYNC_WINDOW_DEFAULT_MS
+#define BOOT_SYNC_WINDOW_DEFAULT_MS 50u
+#endif
+
+/*
+ *@brief Boot configuration, programmed at BOOT_CONFIG_ADDRESS by production or in the field.
+ */
+typedef struct BOOT_Config
+{
+    uint32_t Sync_Window_Ms; /**< UART0 sync window at boot in ms, 0 to start the application at once */
+} BOOT_Config;
+
+/*
+ *@brief Result of the application image check.
+ *@details Any value other than IMAGE_VALID keeps the device in bootloader mode.
+ */
+typedef enum BOOT_Image_Status
+{
+    IMAGE_VALID,                 /* The image can be started */
+    IMAGE_INVALID_STACK_POINTER, /* Initial MSP does not point into RAM (erased or corrupted slot) */
+    IMAGE_INVALID_RESET_VECTOR,  /* Reset vector is outside the application region or not a Thumb address */
+    IMAGE_INVALID_HEADER,        /* No complete image header describing the application slot */
+    IMAGE_INVALID_CRC,           /* Image does not match the CRC32 recorded in its header */
+} BOOT_Image_Status;
 /*******************************************************************************
  * Variables
  ******************************************************************************/
@@ -28,12 +115,39 @@
  * Prototypes
  ******************************************************************************/
 
+/*
+ *@brief Checks that an application slot holds a startable image.
+ *@details The initial MSP must be word aligned and point into RAM (the top of RAM included), and the reset vector
+ *         must point inside the application region with the Thumb bit set. An erased slot (0xFFFFFFFF) fails both.
+ *         The image must then match the header programmed at the end of the last update; the full CRC32 is only
+ *         computed on the first boot after an update and every IMAGE_REVERIFY_INTERVAL boots (see IMAGE.h).
+ *@param Application_Address Address of the slot.
+ *@returns IMAGE_VALID if the image can be started, otherwise the reason why it cannot.
+ */
+BOOT_Image_Status Check_Application_Image(uint32_t Application_Address);
+
+/*
+ *@brief Reads and clears the update request left by the application.
+ *@details The request only counts after a software reset, so RAM contents after power-up are never taken for one.
+ *@returns 1 if the application requested update mode; 0 otherwise.
+ */
+uint8_t Check_Update_Request(void);
+
+/*
+ *@brief Reads the length of the UART0 sync window from the boot configuration.
+ *@returns The window in ms, BOOT_SYNC_WINDOW_DEFAULT_MS if the word is erased, at most BOOT_SYNC_WINDOW_MAX_MS.
+ */
+uint32_t Boot_Sync_Window(void);
+
 /*
  *@brief Jumps to the application code.
- *@details This function performs a jump to the application code located at `APPLICATION_ADDRESS`.
- *         It sets the Main Stack Pointer (MSP) to the value located at the start of the application code,
- *         then retrieves the application's reset handler address and calls it to start execution.
+ *@details This function performs a jump to the application code located at `Application_Address`.
+ *         It disables and clears all NVIC interrupts and the SysTick timer, relocates the vector table (VTOR)
+ *         to the application, sets the Main Stack Pointer (MSP) to the value located at the start of the
+ *         application code, then retrieves the application's reset handler address and calls it to start execution.
+ *         The peripherals used by the bootloader must be returned to their reset state before calling this function.
+ *@param Application_Address Address of the slot holding the application.
  */
-void JumpToApplication(void);
+void JumpToApplication(uint32_t Application_Address);
 
 #endif /* INCLUDES_BOOT_H_ */
@@ -0,0 +1,43 @@
+/**
+ * @file CRC16.h
+ * @brief Header file for the CRC-16 engine.
+ * @details This header file declares the CRC-16/CCITT (polynomial 0x1021, MSB first, no final XOR) used to check
+ *          binary transfer frames. The initial register value selects the variant.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+#ifndef INCLUDES_CRC16_H_
+#define INCLUDES_CRC16_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "MKL46Z4.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define CRC16_INITIAL_VALUE 0xFFFFu /* CRC-16/CCITT-FALSE register value before the first byte */
+#define CRC16_XMODEM_INITIAL_VALUE 0x0000u /* CRC-16/XMODEM register value before the first byte */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief Feeds data into a CRC-16/CCITT computation.
+ *@details Uses a 16-entry table, two lookups per byte. The data may be split across any number of calls.
+ *@param crc The initial register value or the value returned by the previous call.
+ *@param data Pointer to the data.
+ *@param length Number of bytes.
+ *@returns The updated CRC register value, which is the CRC of all the data fed.
+ */
+uint16_t CRC16_Update(uint16_t crc, const uint8_t *data, uint32_t length);
+
+#endif /* INCLUDES_CRC16_H_ */
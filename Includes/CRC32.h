@@ -0,0 +1,80 @@
+/**
+ * @file CRC32.h
+ * @brief Header file for the CRC-32 engine.
+ * @details This header file declares the CRC-32 (IEEE 802.3, reflected polynomial 0xEDB88320) functions used to check
+ *          the application image. The CRC can be computed in one call over memory-mapped flash, or incrementally with
+ *          CRC32_Init / CRC32_Update / CRC32_Final while data is being received. Aligned data is consumed one 32-bit
+ *          word per iteration through a lookup table whose size is selected at build time with `CRC32_TABLE_SIZE`.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+#ifndef INCLUDES_CRC32_H_
+#define INCLUDES_CRC32_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "MKL46Z4.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*
+ *@brief Size of the CRC-32 lookup table.
+ *@details 256: 1 KB table, 4 lookups per word (fastest).
+ *         16: 64 B table, 8 lookups per word (smallest).
+ */
+#ifndef CRC32_TABLE_SIZE
+#define CRC32_TABLE_SIZE 256
+#endif
+
+#if (256 != CRC32_TABLE_SIZE) && (16 != CRC32_TABLE_SIZE)
+#error "CRC32_TABLE_SIZE must be 256 or 16"
+#endif
+
+#define CRC32_INITIAL_VALUE 0xFFFFFFFFu /* Register value before the first byte */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief Starts an incremental CRC-32 computation.
+ *@returns The initial CRC register value.
+ */
+uint32_t CRC32_Init(void);
+
+/*
+ *@brief Feeds data into an incremental CRC-32 computation.
+ *@details Leading and trailing bytes are processed one at a time; the word-aligned part is processed one word per
+ *         iteration. The data may be split across any number of calls at any byte boundary.
+ *@param crc The CRC register value returned by CRC32_Init or the previous CRC32_Update.
+ *@param data Pointer to the data, in RAM or memory-mapped flash.
+ *@param length Number of bytes.
+ *@returns The updated CRC register value.
+ */
+uint32_t CRC32_Update(uint32_t crc, const uint8_t *data, uint32_t length);
+
+/*
+ *@brief Finishes an incremental CRC-32 computation.
+ *@param crc The CRC register value returned by the last CRC32_Update.
+ *@returns The CRC-32 of all the data fed.
+ */
+uint32_t CRC32_Final(uint32_t crc);
+
+/*
+ *@brief Computes the CRC-32 of a buffer in one call.
+ *@param data Pointer to the data, in RAM or memory-mapped flash.
+ *@param length Number of bytes.
+ *@returns The CRC-32 of the data.
+ */
+uint32_t CRC32_Compute(const uint8_t *data, uint32_t length);
+
+#endif /* INCLUDES_CRC32_H_ */
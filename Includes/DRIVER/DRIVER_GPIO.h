@@ -21,6 +21,22 @@
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
+/*
+ *@brief Selects the bus used for pin set, clear, toggle and read operations.
+ *@details 1: the operations go through the zero wait state FGPIO (IOPORT) alias of the port (single-cycle access).
+ *         0: the operations go through the peripheral bridge GPIO mapping.
+ *         Can be overridden from the compiler command line, e.g. -DDRIVER_GPIO_USE_FGPIO=0.
+ */
+#ifndef DRIVER_GPIO_USE_FGPIO
+#define DRIVER_GPIO_USE_FGPIO 1
+#endif
+
+/*
+ *@brief Converts a GPIO base address into the FGPIO (IOPORT) alias of the same port.
+ *@details Both mappings use the same 0x40 byte stride per port, so only the base differs.
+ */
+#define DRIVER_GPIO_TO_FGPIO(GPIOx) ((FGPIO_Type *)(FGPIOA_BASE + ((uint32_t)(GPIOx) - GPIOA_BASE)))
+
 /*
  *@brief Enumeration for GPIO pin states.
  *@details Defines the possible states of a GPIO pin (low or high).
@@ -0,0 +1,67 @@
+/**
+ * @file DRIVER_MCG.h
+ * @brief  Header for the MCG clock profile driver.
+ * @details This file declares the clock profiles the bootloader can run at and the functions to switch between them.
+ *          Both profiles keep the MCG in FEI mode (FLL referenced to the 32.768 kHz slow internal reference, the reset
+ *          mode when CLOCK_SETUP is not defined in system_MKL46Z4.c), so no external crystal is required and MCGFLLCLK
+ *          remains the UART0 clock source.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/05
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+#ifndef INCLUDES_DRIVER_DRIVER_MCG_H_
+#define INCLUDES_DRIVER_DRIVER_MCG_H_
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "MKL46Z4.h"
+#include "../HAL/HAL_MCG.h"
+#include "../HAL/HAL_SIM.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define MCG_FLL_CLOCK_DEFAULT_HZ 20971520u    /* 32768 Hz * 640, FEI reset default */
+#define MCG_FLL_CLOCK_HIGH_SPEED_HZ 47972352u /* 32768 Hz * 1464, FEI mid range with DMX32 */
+
+/*
+ *@brief  Enumerates the available clock profiles.
+ *@details  The bus/flash clock is always core clock / 2 so it stays within the 24 MHz limit.
+ */
+typedef enum MCG_Clock_Profile
+{
+    MCG_CLOCK_PROFILE_DEFAULT,   /* Core 20.97 MHz, bus 10.49 MHz (reset state, expected by the application) */
+    MCG_CLOCK_PROFILE_HIGH_SPEED /* Core 47.97 MHz, bus 23.99 MHz (update session) */
+} MCG_Clock_Profile;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief  Switches the core, bus and FLL clocks to the requested profile.
+ *@details  Waits for the FLL to settle and updates SystemCoreClock. Does nothing if the profile is already active.
+ *          Peripherals clocked from MCGFLLCLK (UART0) must have their divisors recomputed by the caller.
+ *@param  Profile  Clock profile to switch to.
+ *@returns  None
+ */
+void DRIVER_MCG_Set_Clock_Profile(MCG_Clock_Profile Profile);
+
+/*
+ *@brief  Returns the active clock profile.
+ *@returns  The active clock profile.
+ */
+MCG_Clock_Profile DRIVER_MCG_Get_Clock_Profile(void);
+
+/*
+ *@brief  Returns the MCGFLLCLK frequency of the active clock profile.
+ *@returns  MCGFLLCLK frequency in Hz.
+ */
+uint32_t DRIVER_MCG_Get_FLL_Clock(void);
+
+#endif /* INCLUDES_DRIVER_DRIVER_MCG_H_ */
@@ -36,6 +36,12 @@ typedef void (*IRQHandler)(void);
  */
 void DRIVER_NVIC_Enable_External_Interrupt(IRQn_Type Type);
 
+/*
+ *@brief Disable all external interrupts and clear their pending state using the HAL (Hardware Abstraction Layer) function.
+ *@returns No return value
+ */
+void DRIVER_NVIC_Disable_All_External_Interrupts(void);
+
 /*
  *@brief Assign a callback function to handle the interrupt for UART0.
  *@param  Callback: A pointer to the IRQHandler function that will be called when an interrupt occurs.
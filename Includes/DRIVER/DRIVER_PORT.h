@@ -47,6 +47,23 @@ typedef struct PORT_Config
     ISFR_ISF_enum ISFR; /* Interrupt Status Flag Register status */
 } PORT_Config;
 
+/*
+ *@brief Structure for configuring several pins of a PORT with the same settings.
+ *@details The pins selected by Pin_Mask receive the same pin control settings through the Global Pin Control registers.
+ *         The global write replaces bits 15:0 of each selected PCR, so fields not listed in PORT_PCR_field are cleared.
+ */
+typedef struct PORT_Batch_Config
+{
+    PORT_Type *PORTx;   /* Pointer to the PORT peripheral base address */
+    uint32_t Pin_Mask;  /* Bit n set selects pin n */
+    PORT_PCR_field PCR; /* Pin Control Register settings applied to every selected pin */
+} PORT_Batch_Config;
+
+/*
+ *@brief Builds the PCR[15:0] image of a pin configuration, usable at compile time.
+ */
+#define DRIVER_PORT_PCR_IMAGE(MUX, PS, PE) (PORT_PCR_MUX(MUX) | PORT_PCR_PS(PS) | PORT_PCR_PE(PE))
+
 /*******************************************************************************
  * Variables
  ******************************************************************************/
@@ -61,6 +78,15 @@ typedef struct PORT_Config
  */
 void DRIVER_PORT_Config(PORT_Config *PORT_Config);
 
+/*
+ *@brief Configures several pins of a PORT with one Global Pin Control write per half-port.
+ *@details Pins 0..15 are written through GPCLR and pins 16..31 through GPCHR. IRQC lies outside the global write range,
+ *         so a non-default IRQC is applied afterwards with one PCR write per selected pin.
+ *@param PORT_Batch_Config Pointer to a PORT_Batch_Config structure that contains the pin mask and the settings.
+ *@returns None
+ */
+void DRIVER_PORT_Config_Batch(PORT_Batch_Config *PORT_Batch_Config);
+
 /*
  *@brief Clears the interrupt status flag for a specified pin.
  *@param PORTx Pointer to the PORT peripheral base address.
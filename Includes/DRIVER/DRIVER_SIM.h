@@ -118,6 +118,19 @@ typedef struct SIM_Config
     SIM_SOPT2_field Initialize_SOPT2;  /* SOPT2 System Options Register */
 } SIM_Config;
 
+/*
+ *@brief  Register masks computed from a SIM_Config structure.
+ *@details  Used by the batch functions so each SIM register is written at most once.
+ */
+typedef struct SIM_Register_Masks
+{
+    uint32_t SCGC4;       /* SCGC4 clock gates selected */
+    uint32_t SCGC5;       /* SCGC5 clock gates selected */
+    uint32_t SCGC6;       /* SCGC6 clock gates selected */
+    uint32_t SOPT2_Mask;  /* SOPT2 fields selected */
+    uint32_t SOPT2_Value; /* SOPT2 values of the selected fields */
+} SIM_Register_Masks;
+
 /*******************************************************************************
  * Variables
  ******************************************************************************/
@@ -132,4 +145,22 @@ typedef struct SIM_Config
  */
 void DRIVER_SIM_Config(SIM_Config *SIM_Config);
 
+/*
+ *@brief  Applies every field of the configuration structure, writing each SIM register at most once.
+ *@details  Declare_SIM_Register is ignored. Clock gates set to CLOCK_STATE_ENABLE are enabled, other gates are left
+ *          unchanged. SOPT2 fields are only updated when they hold a non-zero (non reset) selection.
+ *@param  SIM_Config  Pointer to a SIM_Config structure that contains the settings of all registers.
+ *@returns  None
+ */
+void DRIVER_SIM_Config_Batch(SIM_Config *SIM_Config);
+
+/*
+ *@brief  Returns the registers selected by the configuration structure to their reset values.
+ *@details  Counterpart of DRIVER_SIM_Config_Batch: clock gates set to CLOCK_STATE_ENABLE are disabled and the selected
+ *          SOPT2 fields are cleared. Each SIM register is written at most once.
+ *@param  SIM_Config  Pointer to the SIM_Config structure that was used to configure the SIM.
+ *@returns  None
+ */
+void DRIVER_SIM_Reset_Batch(SIM_Config *SIM_Config);
+
 #endif /* INCLUDES_DRIVER_DRIVER_SIM_H_ */
@@ -66,6 +66,27 @@ typedef struct UART_Configure
     UART_C2_field C2;   /* UART Control Register 2 */
 } UART_Config;
 
+/*
+ *@brief  UART register image structure
+ *@details  Final values of the BDH, BDL and C2 registers. Applying an image writes each register exactly once.
+ */
+typedef struct UART_Register_Image
+{
+    uint8_t BDH; /* UART Baud Rate Register High image */
+    uint8_t BDL; /* UART Baud Rate Register Low image */
+    uint8_t C2;  /* UART Control Register 2 image */
+} UART_Image;
+
+/*
+ *@brief  Compile-time helpers to build a UART_Image from constant settings
+ *@details  SBR = UART clock / (Baud rate * oversampling ratio), rounded to the nearest integer.
+ */
+#define DRIVER_UART_SBR(CLOCK_HZ, BAUD_RATE, OVERSAMPLING) \
+    (((CLOCK_HZ) + ((BAUD_RATE) * (OVERSAMPLING)) / 2u) / ((BAUD_RATE) * (OVERSAMPLING)))
+#define DRIVER_UART_BDH_IMAGE(SBR, SBNS) (UART_BDH_SBR((SBR) >> 8) | UART_BDH_SBNS(SBNS))
+#define DRIVER_UART_BDL_IMAGE(SBR) (UART_BDL_SBR((SBR) & 0xFFu))
+#define DRIVER_UART_C2_IMAGE(TE, RE, RIE) (UART_C2_TE(TE) | UART_C2_RE(RE) | UART_C2_RIE(RIE))
+
 /*******************************************************************************
  * Variables
  ******************************************************************************/
@@ -80,6 +101,27 @@ typedef struct UART_Configure
  */
 void DRIVER_UART_Config(UART_Config *UART_Config);
 
+/*
+ *@brief  Apply precomputed register images to the UART peripheral
+ *@details  Writes BDH, BDL and C2 exactly once each, BDH first because the baud rate divisor is latched on the BDL write.
+ *@param  UARTx: Pointer to the UART peripheral
+ *@param  UART_Image: Pointer to the register images to apply
+ *@returns  None
+ */
+void DRIVER_UART_Config_Image(UART_Type *UARTx, const UART_Image *UART_Image);
+
+/*
+ *@brief  Recompute and apply the baud rate divisor for a new module clock
+ *@details  The transmitter and receiver are disabled while BDH/BDL are written and C2 is restored afterwards.
+ *          Callers should make sure the last transmission has completed.
+ *@param  UARTx: Pointer to the UART peripheral
+ *@param  Clock_Hz: UART module clock in Hz
+ *@param  Baud_Rate: Requested baud rate
+ *@param  Oversampling: Receiver oversampling ratio (16 for UART1/UART2, OSR + 1 for UART0)
+ *@returns  None
+ */
+void DRIVER_UART_Set_Baud_Rate(UART_Type *UARTx, uint32_t Clock_Hz, uint32_t Baud_Rate, uint8_t Oversampling);
+
 /*
  *@brief  Check if the UART receive data register is full
  *@param  UARTx: Pointer to the UART peripheral
@@ -94,6 +136,13 @@ S1_RDRF_enum DRIVER_UART_S1_Receive_Data_Register_Full_Flag(UART_Type *UARTx);
  */
 S1_TC_enum DRIVER_UART_S1_Transmission_Complete_Flag(UART_Type *UARTx);
 
+/*
+ *@brief  Clear the UART receiver overrun flag
+ *@param  UARTx: Pointer to the UART peripheral
+ *@returns  None
+ */
+void DRIVER_UART_S1_Clear_Overrun_Flag(UART_Type *UARTx);
+
 /*
  *@brief  Write data to the UART transmit data buffer
  *@param  UARTx: Pointer to the UART peripheral
@@ -0,0 +1,89 @@
+/**
+ * @file ECDSA.h
+ * @brief Header file for the ECDSA P-256 signature verification.
+ * @details This header file declares the ECDSA verification over the NIST P-256 curve used to accept only signed
+ *          images. The verification is split into steps of one scalar bit each, so it can run in the idle time of
+ *          the update loop without stalling UART reception. Big numbers are 8 little-endian 32-bit limbs; field and
+ *          scalar multiplications use Montgomery arithmetic.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+#ifndef INCLUDES_ECDSA_H_
+#define INCLUDES_ECDSA_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "MKL46Z4.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define ECDSA_P256_WORDS 8u           /* 256-bit numbers as 32-bit limbs */
+#define ECDSA_P256_KEY_SIZE 64u       /* Public key: X || Y, big-endian */
+#define ECDSA_P256_SIGNATURE_SIZE 64u /* Signature: r || s, big-endian */
+#define ECDSA_P256_DIGEST_SIZE 32u    /* SHA-256 digest */
+
+/*
+ *@brief Result of a signature verification.
+ */
+typedef enum ECDSA_Status
+{
+    ECDSA_IDLE,    /* No verification started */
+    ECDSA_BUSY,    /* Verification in progress, call ECDSA_P256_Verify_Step again */
+    ECDSA_VALID,   /* Signature is valid */
+    ECDSA_INVALID, /* Signature is not valid */
+} ECDSA_Status;
+
+/*
+ *@brief State of a stepwise ECDSA P-256 verification.
+ *@details Point coordinates are kept in Jacobian form and in the Montgomery domain.
+ */
+typedef struct ECDSA_P256_Context
+{
+    uint32_t R[ECDSA_P256_WORDS];  /**< Signature r */
+    uint32_t U1[ECDSA_P256_WORDS]; /**< e / s mod n, multiplier of G */
+    uint32_t U2[ECDSA_P256_WORDS]; /**< r / s mod n, multiplier of the public key */
+    uint32_t GX[ECDSA_P256_WORDS]; /**< Generator X */
+    uint32_t GY[ECDSA_P256_WORDS]; /**< Generator Y */
+    uint32_t QX[ECDSA_P256_WORDS]; /**< Public key X */
+    uint32_t QY[ECDSA_P256_WORDS]; /**< Public key Y */
+    uint32_t X[ECDSA_P256_WORDS];  /**< Accumulator X */
+    uint32_t Y[ECDSA_P256_WORDS];  /**< Accumulator Y */
+    uint32_t Z[ECDSA_P256_WORDS];  /**< Accumulator Z, 0 for the point at infinity */
+    int16_t Bit;                   /**< Next scalar bit to process, -1 when the ladder is done */
+    ECDSA_Status Status;           /**< Result so far */
+} ECDSA_P256_Context;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief Starts the verification of a signature over a SHA-256 digest.
+ *@details Checks the ranges of r and s, computes the two scalars and prepares the ladder. Takes about as long as
+ *         the heaviest ladder step, 6 ms on the target at 47.97 MHz (tools/ecdsa_bench).
+ *@param Context Pointer to the context to initialize.
+ *@param Public_Key Pointer to the public key, X || Y big-endian.
+ *@param Digest Pointer to the SHA-256 digest of the signed data.
+ *@param Signature Pointer to the signature, r || s big-endian.
+ */
+void ECDSA_P256_Verify_Start(ECDSA_P256_Context *Context, const uint8_t *Public_Key, const uint8_t *Digest,
+                             const uint8_t *Signature);
+
+/*
+ *@brief Runs one step of a started verification.
+ *@details Each step processes one of the 256 scalar bits (one point doubling and up to two point additions);
+ *         the last step compares the result with r.
+ *@param Context Pointer to the context.
+ *@returns ECDSA_BUSY while steps remain, then ECDSA_VALID or ECDSA_INVALID.
+ */
+ECDSA_Status ECDSA_P256_Verify_Step(ECDSA_P256_Context *Context);
+
+#endif /* INCLUDES_ECDSA_H_ */
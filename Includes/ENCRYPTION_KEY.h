@@ -0,0 +1,27 @@
+/**
+ * @file ENCRYPTION_KEY.h
+ * @brief Key used to decrypt encrypted application images.
+ * @details This header file holds the AES-128 key of encrypted images. The key below is a development key; replace
+ *          it with the production key before release and keep this file out of public builds. Images are encrypted
+ *          in CTR mode over the image bytes, e.g. with
+ *          `openssl enc -aes-128-ctr -K <key> -iv <initial counter> -in image.bin -out image.enc`, where image.bin is
+ *          the application image with gaps filled with 0xFF.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+#ifndef INCLUDES_ENCRYPTION_KEY_H_
+#define INCLUDES_ENCRYPTION_KEY_H_
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define ENCRYPTION_KEY_AES128 \
+    { \
+        0x64, 0x43, 0x7D, 0xA2, 0x92, 0xF5, 0xFC, 0x01, 0xFA, 0x61, 0xA4, 0xF5, 0x42, 0xED, 0x90, 0xCC \
+    }
+
+#endif /* INCLUDES_ENCRYPTION_KEY_H_ */
@@ -0,0 +1,119 @@
+/**
+ * @file FRAME.h
+ * @brief Header file for the binary transfer frames.
+ * @details This header file defines a compact binary alternative to S-record lines. A session sends FRAME_HANDSHAKE
+ *          as its very first byte to select frames; the bootloader answers FRAME_HANDSHAKE_ACK. Any other first byte
+ *          keeps the session on S-record lines.
+ *
+ *          Frame layout (multi-byte fields big-endian):
+ *          - Sync byte FRAME_SYNC
+ *          - Type: the S-record type digit the frame stands for ('0', '1' or '9')
+ *          - Sequence number, 0 for the first frame, wrapping after 255
+ *          - Payload length, at most FRAME_MAX_PAYLOAD
+ *          - 32-bit address (load address for '1', record tag for '0', entry point for '9')
+ *          - Payload
+ *          - CRC-16/CCITT-FALSE over type, sequence, length, address and payload
+ *
+ *          A frame carries exactly what the record of the same type carries, so the update flow is the same for both.
+ *          A 64-byte data frame takes 74 bytes on the wire, where S-records take 4 lines of 44 characters.
+ *
+ *          Frames are sent through a sliding window: the host keeps up to FRAME_WINDOW frames unacknowledged. Once a
+ *          frame is processed the bootloader sends FRAME_ACK and its sequence number, which acknowledges every frame
+ *          up to it. When a frame is corrupted, or one arrives ahead of a missing one, the bootloader sends FRAME_NAK
+ *          and the sequence number of the missing frame; the host resends that frame only, the frames after it are
+ *          kept. The host resends the oldest unacknowledged frame when no answer comes. The bootloader's text
+ *          messages contain neither FRAME_ACK nor FRAME_NAK, so the host can skip them. A frame announcing raw bytes
+ *          (compressed image or patch) closes the window: the host sends the raw bytes once it is acknowledged.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+#ifndef INCLUDES_FRAME_H_
+#define INCLUDES_FRAME_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "MKL46Z4.h"
+#include "SREC.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define FRAME_HANDSHAKE 0x16u      /* First byte of a session using frames (SYN); STX starts an XMODEM-1K block */
+#define FRAME_HANDSHAKE_ACK 0x06u  /* Bootloader answer to the handshake (ACK) */
+#define FRAME_ACK 0x06u            /* Followed by the sequence number of the last frame processed */
+#define FRAME_NAK 0x15u            /* Followed by the sequence number of the frame to resend */
+#define FRAME_WINDOW 6u            /* Frames the host may send ahead of the last acknowledgement */
+#define FRAME_SYNC 0xA5u           /* First byte of every frame */
+#define FRAME_TYPE_INDEX 1u        /* Offset of the type byte */
+#define FRAME_SEQUENCE_INDEX 2u    /* Offset of the sequence number */
+#define FRAME_LENGTH_INDEX 3u      /* Offset of the payload length byte */
+#define FRAME_ADDRESS_INDEX 4u     /* Offset of the address */
+#define FRAME_HEADER_SIZE 8u       /* Sync, type, sequence, length and address */
+#define FRAME_CRC_SIZE 2u          /* CRC-16 after the payload */
+#define FRAME_MAX_PAYLOAD 64u      /* Largest payload, keeps a frame within a queue element */
+#define FRAME_RECORD_OVERHEAD 3u   /* S-record byte count of a record without data: 2 address bytes + 1 checksum */
+
+#if (FRAME_HEADER_SIZE + FRAME_MAX_PAYLOAD + FRAME_CRC_SIZE > MAX_LINE_LENGTH_RECORD)
+#error "A frame must fit in a queue element"
+#endif
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief Returns the total size of a frame from its header.
+ *@param frame Pointer to the frame, at least FRAME_LENGTH_INDEX + 1 bytes received.
+ *@returns Number of bytes of the whole frame; 0 if the length is invalid.
+ */
+uint8_t FRAME_Size(volatile char *frame);
+
+/*
+ *@brief Adds a received byte to the frame being collected.
+ *@details Bytes outside a frame are dropped until a sync byte. A frame with an invalid length byte is dropped, and
+ *         collection resynchronizes on the next sync byte.
+ *@param frame Pointer to the queue element collecting the frame.
+ *@param Index Pointer to the number of bytes collected, 0 between frames.
+ *@param Data The received byte.
+ *@returns 1 once the frame is complete, *Index being back to 0; 0 otherwise.
+ */
+uint8_t FRAME_Collect(volatile char *frame, volatile uint8_t *Index, uint8_t Data);
+
+/*
+ *@brief Checks the sync byte, length and CRC of a complete frame.
+ *@param frame Pointer to the complete frame.
+ *@returns 1 if the frame is intact; 0 otherwise.
+ */
+uint8_t FRAME_Check(volatile char *frame);
+
+/*
+ *@brief Builds a frame.
+ *@details Used to turn data received by other means into frames the update loop processes like received ones.
+ *@param frame Pointer to the destination, at least FRAME_HEADER_SIZE + Length + FRAME_CRC_SIZE bytes long.
+ *@param Type The S-record type digit the frame stands for ('0', '1' or '9').
+ *@param Sequence The sequence number.
+ *@param Address The address field.
+ *@param Data Pointer to the payload.
+ *@param Length Number of payload bytes, at most FRAME_MAX_PAYLOAD.
+ *@returns None
+ */
+void FRAME_Build(volatile char *frame, char Type, uint8_t Sequence, uint32_t Address, const uint8_t *Data, uint8_t Length);
+
+/*
+ *@brief Validates a frame and fills the Record structure.
+ *@details data1 to data4 receive the first 16 payload bytes, as record_parser does for S-records.
+ *@param frame Pointer to the complete frame.
+ *@param record_struct Pointer to the Record structure to be filled.
+ *@param data Buffer receiving the whole payload, at least FRAME_MAX_PAYLOAD bytes long.
+ *@returns The byte count of the equivalent S-record (payload length + FRAME_RECORD_OVERHEAD) if valid; 0 if invalid.
+ */
+uint8_t FRAME_Parse(volatile char *frame, Record *record_struct, uint8_t *data);
+
+#endif /* INCLUDES_FRAME_H_ */
@@ -6,6 +6,7 @@
  *          This file provides the interface for GPIO operations such as setting pin direction, reading/writing pin states,
  *          toggling pin states, and configuring pull-up/pull-down resistors.
  *          It is designed to abstract hardware-specific details and provide a consistent API for GPIO operations.
+ *          The HAL_FGPIO_* variants access the same ports through the single-cycle FGPIO (IOPORT) alias.
  * @author Nguyen Dang Nhu Tri
  * @version 1.0
  * @date 2024/07/05
@@ -131,4 +132,38 @@ PDIR_PDI_enum HAL_GPIO_PDIR_Data_Input(GPIO_Type *GPIOx, uint8_t Pin);
  */
 PDOR_Output_Pin_State HAL_GPIO_PDOR_Read_Output_Pin(GPIO_Type *GPIOx, uint8_t Pin);
 
+/*
+ *@brief Sets the output state of a GPIO pin to high through the FGPIO (IOPORT) alias.
+ *@param FGPIOx Pointer to the FGPIO base address.
+ *@param Pin The pin number to configure.
+ *@param PinState The desired pin state (not used in this function).
+ *@returns None
+ */
+void HAL_FGPIO_PSOR_Port_Set_Output(FGPIO_Type *FGPIOx, uint8_t Pin, PSOR_PTSO_enum PinState);
+
+/*
+ *@brief Clears the output state of a GPIO pin to low through the FGPIO (IOPORT) alias.
+ *@param FGPIOx Pointer to the FGPIO base address.
+ *@param Pin The pin number to configure.
+ *@param PinState The desired pin state (not used in this function).
+ *@returns None
+ */
+void HAL_FGPIO_PCOR_Port_Clear_Output(FGPIO_Type *FGPIOx, uint8_t Pin, PCOR_PTCO_enum PinState);
+
+/*
+ *@brief Toggles the output state of a GPIO pin through the FGPIO (IOPORT) alias.
+ *@param FGPIOx Pointer to the FGPIO base address.
+ *@param Pin The pin number to toggle.
+ *@returns None
+ */
+void HAL_FGPIO_PTOR_Toggle_Output(FGPIO_Type *FGPIOx, uint8_t Pin);
+
+/*
+ *@brief Reads the data input state of a GPIO pin through the FGPIO (IOPORT) alias.
+ *@param FGPIOx Pointer to the FGPIO base address.
+ *@param Pin The pin number to read.
+ *@returns The current state of the pin (logic 0 or logic 1).
+ */
+PDIR_PDI_enum HAL_FGPIO_PDIR_Data_Input(FGPIO_Type *FGPIOx, uint8_t Pin);
+
 #endif /* INCLUDES_HAL_HAL_GPIO_H_ */
@@ -0,0 +1,78 @@
+/**
+ * @file HAL_MCG.h
+ * @brief  Header file for HAL functions for the MCG module.
+ * @details This file provides declarations for functions and enums used for selecting the FLL output range of the
+ *          Multipurpose Clock Generator (MCG) and reading its clock mode status.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/05
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+#ifndef INCLUDES_HAL_HAL_MCG_H_
+#define INCLUDES_HAL_HAL_MCG_H_
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "MKL46Z4.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*
+ *@brief  Selects the DCO range of the FLL.
+ *@details  With the 32.768 kHz slow internal reference, the FLL factor is 640/1280/1920/2560 (DMX32 = 0)
+ *          or 732/1464/2197/2929 (DMX32 = 1).
+ */
+typedef enum MCG_C4_DRST_DRS_DCO_Range_Select
+{
+	C4_DRST_DRS_LOW = 0b00,		 /* Encoding 0 - Low range (reset default) */
+	C4_DRST_DRS_MID = 0b01,		 /* Encoding 1 - Mid range */
+	C4_DRST_DRS_MID_HIGH = 0b10, /* Encoding 2 - Mid-high range */
+	C4_DRST_DRS_HIGH = 0b11,	 /* Encoding 3 - High range */
+} C4_DRST_DRS_enum;
+
+/*
+ *@brief  Selects the DCO maximum frequency.
+ *@details  Fine-tuned range is only valid with a 32.768 kHz reference.
+ */
+typedef enum MCG_C4_DMX32_DCO_Maximum_Frequency
+{
+	C4_DMX32_DEFAULT_RANGE = 0, /* DCO has a default range of 25% */
+	C4_DMX32_FINE_TUNED = 1,	/* DCO is fine-tuned for maximum frequency with 32.768 kHz reference */
+} C4_DMX32_enum;
+
+/*
+ *@brief  Clock mode status of the MCG output.
+ */
+typedef enum MCG_S_CLKST_Clock_Mode_Status
+{
+	S_CLKST_FLL = 0b00,		 /* Output of the FLL is selected */
+	S_CLKST_INTERNAL = 0b01, /* Internal reference clock is selected */
+	S_CLKST_EXTERNAL = 0b10, /* External reference clock is selected */
+	S_CLKST_PLL = 0b11,		 /* Output of the PLL is selected */
+} S_CLKST_enum;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief  Selects the FLL DCO range and maximum frequency with a single write, keeping the trim values.
+ *@param   dmx32  DCO maximum frequency selection.
+ *@param   range  DCO range selection.
+ *@returns None
+ */
+void HAL_MCG_C4_FLL_Range_Select(C4_DMX32_enum dmx32, C4_DRST_DRS_enum range);
+
+/*
+ *@brief  Reads the clock mode status of the MCG output.
+ *@returns The clock source currently driving MCGOUTCLK.
+ */
+S_CLKST_enum HAL_MCG_S_Clock_Mode_Status(void);
+
+#endif /* INCLUDES_HAL_HAL_MCG_H_ */
@@ -40,4 +40,10 @@ void HAL_NVIC_Enable_External_Interrupt(IRQn_Type Type);
  */
 void HAL_NVIC_Disable_External_Interrupt(IRQn_Type Type);
 
+/*
+ *@brief Disable all external interrupts and clear their pending state.
+ *@returns No return value
+ */
+void HAL_NVIC_Disable_All_External_Interrupts(void);
+
 #endif /* INCLUDES_HAL_HAL_NVIC_H_ */
@@ -147,6 +147,37 @@ void HAL_UART_C2_Receiverr_Enable(UART_Type *UARTx, C2_RE_enum state);
  */
 void HAL_UART_C2_Receiver_Interrupt_Enable_for_RDRF(UART_Type *UARTx, C2_RIE_enum state);
 
+/*
+ *@brief  Write the whole UART Baud Rate Register High
+ *@param  UARTx: Pointer to the UART peripheral
+ *@param  value: Register image to be written
+ *@returns  None
+ */
+void HAL_UART_BDH_Write_Register(UART_Type *UARTx, uint8_t value);
+
+/*
+ *@brief  Write the whole UART Baud Rate Register Low
+ *@param  UARTx: Pointer to the UART peripheral
+ *@param  value: Register image to be written
+ *@returns  None
+ */
+void HAL_UART_BDL_Write_Register(UART_Type *UARTx, uint8_t value);
+
+/*
+ *@brief  Write the whole UART Control Register 2
+ *@param  UARTx: Pointer to the UART peripheral
+ *@param  value: Register image to be written
+ *@returns  None
+ */
+void HAL_UART_C2_Write_Register(UART_Type *UARTx, uint8_t value);
+
+/*
+ *@brief  Read the whole UART Control Register 2
+ *@param  UARTx: Pointer to the UART peripheral
+ *@returns  uint8_t: Current register value
+ */
+uint8_t HAL_UART_C2_Read_Register(UART_Type *UARTx);
+
 /*
  *@brief  Check the UART receive data register full flag
  *@param  UARTx: Pointer to the UART peripheral
@@ -161,6 +192,15 @@ S1_RDRF_enum HAL_UART_S1_Receive_Data_Register_Full_Flag(UART_Type *UARTx);
  */
 S1_TC_enum HAL_UART_S1_Transmission_Complete_Flag(UART_Type *UARTx);
 
+/*
+ *@brief  Clear the UART receiver overrun flag
+ *@details  OR is write-1-to-clear on UART0; UART1 and UART2 clear it by reading S1 then D, which drops the
+ *          character in D. While it is set, no received character is moved into D.
+ *@param  UARTx: Pointer to the UART peripheral
+ *@returns  None
+ */
+void HAL_UART_S1_Clear_Overrun_Flag(UART_Type *UARTx);
+
 /*
  *@brief  Write to the UART transmit data buffer
  *@param  UARTx: Pointer to the UART peripheral
@@ -0,0 +1,269 @@
+/**
+ * @file IMAGE.h
+ * @brief Header file for the application image header.
+ * @details This header file defines the image header that describes an application image (length, load address,
+ *          version and CRC32) and the functions to parse it from the update stream, program it into flash and check an
+ *          installed image against it. The flash above the bootloader holds two application slots, A at
+ *          `APPLICATION_ADDRESS` and B IMAGE_SLOT_STRIDE above it; an image is linked for the slot it runs from. Each
+ *          slot has its header in its own flash sector directly below it, so the header can be erased at the start of
+ *          an update and programmed last, once the whole image has been written and verified.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+#ifndef INCLUDES_IMAGE_H_
+#define INCLUDES_IMAGE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "MKL46Z4.h"
+#include "SREC.h"
+#include "BOOT.h"
+#include "SHA256.h"
+#include "ECDSA.h"
+#include "AES128.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define IMAGE_SECTOR_SIZE 0x400u                                         /* Program flash sector size, 1 KB */
+#define IMAGE_HEADER_ADDRESS (APPLICATION_ADDRESS - IMAGE_SECTOR_SIZE)   /* Header sector of slot A, directly below it */
+#define IMAGE_SLOT_COUNT 2u                                              /* Slot A at APPLICATION_ADDRESS, slot B above it */
+#define IMAGE_SLOT_STRIDE ((((FLASH_END_ADDRESS - IMAGE_HEADER_ADDRESS) / IMAGE_SLOT_COUNT) / IMAGE_SECTOR_SIZE) * IMAGE_SECTOR_SIZE) /* Header sector + slot */
+#define IMAGE_SLOT_SIZE (IMAGE_SLOT_STRIDE - IMAGE_SECTOR_SIZE)          /* Largest image an application slot can hold */
+#define IMAGE_SLOT_ADDRESS(Slot) (APPLICATION_ADDRESS + (uint32_t)(Slot) * IMAGE_SLOT_STRIDE) /* Slot 0 (A) or 1 (B) */
+#define IMAGE_SLOT_HEADER_ADDRESS(Load_Address) ((Load_Address) - IMAGE_SECTOR_SIZE) /* Header sector of a slot */
+#define IMAGE_HEADER_MAGIC 0x31474D49u                                   /* "IMG1" in memory, programmed last */
+#define IMAGE_HEADER_RECORD_BYTE_COUNT 0x13u                             /* S0 byte count: 2 address + 16 header + 1 checksum */
+#define IMAGE_DIGEST_RECORD_BYTE_COUNT 0x23u                             /* S0 byte count: 2 address + 32 bytes + 1 checksum */
+#define IMAGE_RECORD_TAG_HEADER 0x0000u                                  /* S0 address of the image header record */
+#define IMAGE_RECORD_TAG_DIGEST 0x0000u                                  /* S0 address of the image digest record */
+#define IMAGE_RECORD_TAG_SIGNATURE_R 0x0001u                             /* S0 address of the signature r record */
+#define IMAGE_RECORD_TAG_SIGNATURE_S 0x0002u                             /* S0 address of the signature s record */
+#define IMAGE_RECORD_TAG_COUNTER 0x0003u                                 /* S0 address of the AES-CTR initial counter record */
+#define IMAGE_COUNTER_RECORD_BYTE_COUNT 0x13u                            /* S0 byte count: 2 address + 16 counter + 1 checksum */
+#define IMAGE_RECORD_TAG_COMPRESSED 0x0004u                              /* S0 address of the compressed image record */
+#define IMAGE_COMPRESSED_RECORD_BYTE_COUNT 0x07u                         /* S0 byte count: 2 address + 4 length + 1 checksum */
+#define IMAGE_RECORD_TAG_PATCH 0x0005u                                   /* S0 address of the delta patch record */
+#define IMAGE_PATCH_RECORD_BYTE_COUNT 0x13u                              /* S0 byte count: 2 address + 16 patch fields + 1 checksum */
+#define IMAGE_BOOT_LOG_ADDRESS (BOOT_CONFIG_ADDRESS + IMAGE_SECTOR_SIZE) /* Boot log sectors, above the boot configuration */
+#define IMAGE_BOOT_LOG_SECTORS 2u                                        /* Used in turn, see Image_Boot_Log */
+#define IMAGE_BOOT_LOG_MAGIC 0x31474F4Cu                                 /* "LOG1" in memory, programmed after the identity */
+#define IMAGE_BOOT_LOG_FULL_CHECK 0x4C4C5546u                            /* "FULL": boot verified the whole image CRC */
+#define IMAGE_BOOT_LOG_QUICK_CHECK 0x4B495551u                           /* "QUIK": boot trusted the previous full check */
+
+/*
+ *@brief Refuse images without a valid ECDSA P-256 signature (see SIGNING_KEY.h).
+ */
+#ifndef IMAGE_REQUIRE_SIGNATURE
+#define IMAGE_REQUIRE_SIGNATURE BOOT_FEATURE_SIGNATURE
+#endif
+
+#if (IMAGE_REQUIRE_SIGNATURE && !BOOT_FEATURE_SIGNATURE)
+#error "IMAGE_REQUIRE_SIGNATURE needs BOOT_FEATURE_SIGNATURE"
+#endif
+
+/*
+ *@brief Number of boots between two full image CRC checks.
+ *@details The first boot after an update always runs the full check.
+ */
+#ifndef IMAGE_REVERIFY_INTERVAL
+#define IMAGE_REVERIFY_INTERVAL 64u
+#endif
+
+/*
+ *@brief Header describing the application image.
+ *@details Stored in the header sector of its slot. `Magic` is programmed after every other field, so a header whose
+ *         programming was interrupted is never taken as valid. In the update stream the header is carried by an S0
+ *         record with a byte count of 0x13 whose 16 data bytes are Image_Length, Load_Address, Image_Version and
+ *         Image_CRC32, each big-endian.
+ */
+typedef struct Image_Header
+{
+    uint32_t Magic;         /**< IMAGE_HEADER_MAGIC once the header is complete */
+    uint32_t Image_Length;  /**< Number of image bytes starting at Load_Address */
+    uint32_t Load_Address;  /**< Address of the application vector table */
+    uint32_t Image_Version; /**< Application version, 0 if the update stream did not provide one */
+    uint32_t Image_CRC32;   /**< CRC-32 (IEEE 802.3) over Image_Length bytes from Load_Address */
+} Image_Header;
+
+#define IMAGE_BOOT_LOG_WORDS ((IMAGE_SECTOR_SIZE / sizeof(uint32_t)) - 4u) /* Rest of a boot log sector */
+
+/*
+ *@brief Layout of a boot log sector.
+ *@details A boot log belongs to the image identified by its Load_Address and Image_CRC32. Each boot of that image
+ *         programs the next erased Entries word, with IMAGE_BOOT_LOG_FULL_CHECK when it verified the CRC over the
+ *         whole image and IMAGE_BOOT_LOG_QUICK_CHECK when it relied on an earlier full check. Flash words are only
+ *         programmed once per erase, so a boot costs no erase cycle.
+ *
+ *         The current log is the complete one with the highest Sequence. A new log is started in the other sector
+ *         when the current one is full or belongs to another image, which makes the first boot of an update run the
+ *         full check. The current log stays valid until the identity of the new one is complete, and the header
+ *         sectors are never erased outside an update, so a power loss while a log is started only costs a full check.
+ */
+typedef struct Image_Boot_Log
+{
+    uint32_t Magic;                         /**< IMAGE_BOOT_LOG_MAGIC once the identity is complete */
+    uint32_t Sequence;                      /**< One more than the sequence of the log it replaced */
+    uint32_t Load_Address;                  /**< Slot of the image logged */
+    uint32_t Image_CRC32;                   /**< CRC-32 of the image logged, from its header */
+    uint32_t Entries[IMAGE_BOOT_LOG_WORDS]; /**< One word per boot, 0xFFFFFFFF if unused */
+} Image_Boot_Log;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief Combines four big-endian bytes into a 32-bit value.
+ *@param data Pointer to the four bytes.
+ *@returns The 32-bit value.
+ */
+uint32_t IMAGE_Bytes_To_Word(const uint8_t *data);
+
+/*
+ *@brief Fills an image header from a parsed S0 header record.
+ *@details Records that do not describe an image fitting the slot being updated (for example the module name S0 record
+ *         emitted by objcopy) are rejected, so a plain S-record file keeps working.
+ *@param record_struct Pointer to the parsed S0 record.
+ *@param byteCount_in_record The byte count in the record.
+ *@param Load_Address Address of the slot being updated.
+ *@param Header Pointer to the header to fill.
+ *@returns 1 if the record is an image header; 0 otherwise.
+ */
+uint8_t IMAGE_Parse_Header_Record(const Record *record_struct, uint8_t byteCount_in_record, uint32_t Load_Address, Image_Header *Header);
+
+/*
+ *@brief Returns the number of flash sectors an image of the given length occupies.
+ *@param Image_Length Image length in bytes.
+ *@returns Number of sectors from the start of the slot.
+ */
+uint8_t IMAGE_Sectors_Required(uint32_t Image_Length);
+
+/*
+ *@brief Computes the CRC-32 of a memory-mapped flash region.
+ *@param Address Start address.
+ *@param Length Number of bytes.
+ *@returns The CRC-32 (IEEE 802.3) of the region.
+ */
+uint32_t IMAGE_Compute_CRC32(uint32_t Address, uint32_t Length);
+
+/*
+ *@brief Programs the image header into the erased header sector of the slot at its Load_Address.
+ *@details The fields are programmed first and `Magic` last. Interrupts must be disabled by the caller.
+ *@param Header Pointer to the header to program; its Magic field is ignored.
+ *@returns 1 if success.
+ */
+uint8_t IMAGE_Write_Header(const Image_Header *Header);
+
+/*
+ *@brief Checks that an installed image is the base a delta patch was built against.
+ *@details In the update stream a patch is announced by an S0 record with a byte count of 0x13 and the address field
+ *         IMAGE_RECORD_TAG_PATCH, whose 16 data bytes are the patch length, the base image length, the base image
+ *         CRC32 and a sector count, each big-endian. The base stays in the active slot while the patch writes the new
+ *         image into the other one, so the sector count, which moved the base up for in-place patching, is ignored.
+ *@param Load_Address Address of the slot holding the base image.
+ *@param Length Length of the base image.
+ *@param CRC32 CRC-32 of the base image.
+ *@returns 1 if the installed header and the flash contents match the base; 0 otherwise.
+ */
+uint8_t IMAGE_Check_Patch_Base(uint32_t Load_Address, uint32_t Length, uint32_t CRC32);
+
+/*
+ *@brief Starts the SHA-256 of the image being received.
+ *@details The digest covers Image_Length bytes from Load_Address, as they end up in flash. In the update stream the
+ *         expected digest is carried by an S0 record with a byte count of 0x23, sent after the header record.
+ *         Without BOOT_FEATURE_SIGNATURE nothing is hashed.
+ *@param Load_Address Address of the slot being updated.
+ */
+void IMAGE_Stream_Start(uint32_t Load_Address);
+
+/*
+ *@brief Feeds data programmed into the application slot to the image SHA-256.
+ *@details Data following the previous data is hashed immediately. A gap is hashed as erased flash (0xFF). Data going
+ *         backwards (retransmitted or out of order records) cannot be streamed; the digest is then computed over
+ *         flash by IMAGE_Stream_Check_Digest. Does nothing without BOOT_FEATURE_SIGNATURE.
+ *@param Address Flash address of the data.
+ *@param Data Pointer to the data.
+ *@param Length Number of bytes.
+ */
+void IMAGE_Stream_Data(uint32_t Address, const uint8_t *Data, uint32_t Length);
+
+/*
+ *@brief Finishes the image SHA-256 and compares it with the expected digest.
+ *@param Header Pointer to the header of the received image.
+ *@param Expected_Digest Pointer to the SHA256_DIGEST_SIZE byte digest from the digest record.
+ *@returns 1 if the digests match; 0 otherwise, always 0 without BOOT_FEATURE_SIGNATURE.
+ */
+uint8_t IMAGE_Stream_Check_Digest(const Image_Header *Header, const uint8_t *Expected_Digest);
+
+#if BOOT_FEATURE_ENCRYPTION
+/*
+ *@brief Enables the decryption of the image being received.
+ *@details Encrypted images are AES-128-CTR encrypted over the image bytes: the key stream block of image offset o is
+ *         AES(Initial_Counter + o / 16), the counter being a 128-bit big-endian number. The key stream therefore
+ *         depends only on the address of the data, so records can arrive out of order or be sent again.
+ *         In the update stream the initial counter is carried by an S0 record with a byte count of 0x13 and the
+ *         address field IMAGE_RECORD_TAG_COUNTER, sent before the first data record.
+ *@param Initial_Counter Pointer to the AES128_BLOCK_SIZE byte counter of image offset 0.
+ */
+void IMAGE_Decrypt_Start(const uint8_t *Initial_Counter);
+#endif
+
+/*
+ *@brief Decrypts data of the image being received in place, if decryption is enabled.
+ *@details Does nothing without BOOT_FEATURE_ENCRYPTION.
+ *@param Address Flash address of the data, inside the slot being updated.
+ *@param Data Pointer to the data.
+ *@param Length Number of bytes.
+ */
+void IMAGE_Decrypt(uint32_t Address, uint8_t *Data, uint32_t Length);
+
+#if BOOT_FEATURE_SIGNATURE
+/*
+ *@brief Starts the verification of the image signature.
+ *@details The signature is over the expected image digest, so it can be verified while the image is still being
+ *         received; IMAGE_Stream_Check_Digest then ties the received image to that digest. In the update stream
+ *         r and s are carried by two S0 records with a byte count of 0x23, tagged by their address field.
+ *@param Digest Pointer to the expected SHA-256 of the image.
+ *@param Signature Pointer to the signature, r || s big-endian.
+ */
+void IMAGE_Signature_Start(const uint8_t *Digest, const uint8_t *Signature);
+#endif
+
+/*
+ *@brief Runs one step of the signature verification, if one is in progress.
+ *@details Called from the update loop after the pending records. UART0 keeps receiving in its interrupt while a
+ *         step runs. The heaviest step, one doubling and two additions, is 30 Montgomery multiplications or about
+ *         5.3 ms at 47.97 MHz (tools/ecdsa_bench), and IMAGE_Signature_Start about 6 ms; UART0 takes 30.6 ms at
+ *         115200 baud, 7.6 ms at 460800 baud, to fill the record queue with 16-byte S1 records.
+ *@returns ECDSA_IDLE if no verification was started or without BOOT_FEATURE_SIGNATURE, ECDSA_BUSY, ECDSA_VALID or
+ *         ECDSA_INVALID.
+ */
+ECDSA_Status IMAGE_Signature_Step(void);
+
+/*
+ *@brief Completes the signature verification.
+ *@returns ECDSA_IDLE if no verification was started or without BOOT_FEATURE_SIGNATURE, ECDSA_VALID or ECDSA_INVALID.
+ */
+ECDSA_Status IMAGE_Signature_Finish(void);
+
+/*
+ *@brief Checks the image installed in a slot against its header in flash and records the boot in the boot log.
+ *@details The header must be complete and describe an image loaded at Load_Address that fits the slot.
+ *         The CRC over exactly Image_Length bytes of the image is then checked on the first boot after an update and
+ *         every `IMAGE_REVERIFY_INTERVAL` boots; the boots in between trust the last full check. When the boot log
+ *         is full, or belongs to another image, a new one is started after a successful full check.
+ *         Interrupts are disabled while the log is programmed, then left masked if they were on entry.
+ *@param Load_Address Address of the slot.
+ *@returns IMAGE_VALID, IMAGE_INVALID_HEADER or IMAGE_INVALID_CRC.
+ */
+BOOT_Image_Status IMAGE_Check_Installed_Image(uint32_t Load_Address);
+
+#endif /* INCLUDES_IMAGE_H_ */
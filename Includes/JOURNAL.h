@@ -0,0 +1,91 @@
+/**
+ * @file JOURNAL.h
+ * @brief Header file for the update progress journal.
+ * @details This header file declares the journal that lets an interrupted update resume where it stopped. The journal
+ *          sector, directly below the header sector of slot A, holds the identity of the image being received (the
+ *          fields of its header record, whose Load_Address is the slot being updated) followed by one entry per
+ *          completed sector of that slot, appended in order as the update goes on. A sector is completed once every
+ *          one of its bytes has been programmed, whatever the order the records arrive in. A new session announcing
+ *          the same image resumes after the last sector whose entry is intact and whose flash contents still match the
+ *          CRC recorded in the entry.
+ *
+ *          Entry layout: bits 0-7 sector index from the start of the slot, bits 8-15 its complement, bits 16-31
+ *          CRC-16/CCITT-FALSE of the sector contents. A half-programmed entry fails the complement or CRC check.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+#ifndef INCLUDES_JOURNAL_H_
+#define INCLUDES_JOURNAL_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "MKL46Z4.h"
+#include "IMAGE.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define JOURNAL_ADDRESS (IMAGE_HEADER_ADDRESS - IMAGE_SECTOR_SIZE) /* Journal sector, directly below the header sector */
+#define JOURNAL_MAGIC 0x314E524Au                                /* "JRN1" in memory, programmed after the identity */
+#define JOURNAL_ENTRIES ((IMAGE_SECTOR_SIZE / 4u) - 5u)          /* Rest of the sector after the identity */
+#define JOURNAL_SLOT_SECTORS (IMAGE_SLOT_SIZE / IMAGE_SECTOR_SIZE) /* Sectors of an application slot */
+
+#if (JOURNAL_SLOT_SECTORS > JOURNAL_ENTRIES)
+#error "The journal must have an entry for every sector of an application slot"
+#endif
+
+/*
+ *@brief Layout of the journal sector.
+ *@details The identity is an image header whose Magic field holds JOURNAL_MAGIC.
+ */
+typedef struct Journal_Sector
+{
+    Image_Header Identity;             /**< Image being received */
+    uint32_t Entries[JOURNAL_ENTRIES]; /**< One word per completed sector, 0xFFFFFFFF if unused */
+} Journal_Sector;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief Finds where an update of the given image can resume.
+ *@details On a match the journal stays active, so the update goes on appending to it. If the entry after the intact
+ *         sectors is stale, the journal is rewritten with the intact ones so that it can record the rest.
+ *@param Identity Pointer to the header announced by the new session.
+ *@returns Address of the first sector to receive again; Identity->Load_Address if nothing can be kept.
+ */
+uint32_t JOURNAL_Resume_Point(const Image_Header *Identity);
+
+/*
+ *@brief Starts a new journal for the given image.
+ *@details Erases the journal sector and programs the identity, JOURNAL_MAGIC last. Interrupts must be disabled by the
+ *         caller.
+ *@param Identity Pointer to the header of the image being received.
+ */
+void JOURNAL_Start(const Image_Header *Identity);
+
+/*
+ *@brief Counts bytes programmed into the slot being updated and records the sectors completed.
+ *@details Appends an entry for each sector, in order, once all its bytes have been counted. A sector completed
+ *         before the ones below it is recorded with them. Does nothing if no journal is active. Interrupts are
+ *         disabled while an entry is programmed.
+ *@param Address Address of the first byte programmed.
+ *@param Length Number of bytes programmed, each counted once.
+ */
+void JOURNAL_Record_Progress(uint32_t Address, uint32_t Length);
+
+/*
+ *@brief Erases the journal once the image is committed.
+ *@details Interrupts must be disabled by the caller.
+ */
+void JOURNAL_Clear(void);
+
+#endif /* INCLUDES_JOURNAL_H_ */
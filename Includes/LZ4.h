@@ -0,0 +1,89 @@
+/**
+ * @file LZ4.h
+ * @brief Header file for the streaming LZ4 frame decoder.
+ * @details This header file declares a byte-at-a-time decoder for the LZ4 frame format, as produced by the `lz4`
+ *          command line tool. The decoder keeps no output window of its own: decoded bytes are handed to an output
+ *          callback, and match copies read earlier output back through a history callback. The bootloader reads the
+ *          history from the flash it has just programmed, so decompression needs only a few bytes of RAM.
+ *          Dictionary IDs are not supported; block and content checksums are skipped, the image is checked by its
+ *          header CRC and digest instead.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+#ifndef INCLUDES_LZ4_H_
+#define INCLUDES_LZ4_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "MKL46Z4.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*
+ *@brief Receives one decoded byte.
+ */
+typedef void (*LZ4_Output_Callback)(uint8_t Data);
+
+/*
+ *@brief Returns the decoded byte Distance bytes before the next output byte (1 = last byte output).
+ */
+typedef uint8_t (*LZ4_History_Callback)(uint16_t Distance);
+
+/*
+ *@brief Result of feeding a byte to the decoder.
+ */
+typedef enum LZ4_Status
+{
+    LZ4_BUSY,  /* More input expected */
+    LZ4_DONE,  /* End mark (and content checksum) consumed */
+    LZ4_ERROR, /* Not an LZ4 frame, unsupported option or corrupted data */
+} LZ4_Status;
+
+/*
+ *@brief State of a streaming LZ4 frame decoding.
+ */
+typedef struct LZ4_Context
+{
+    LZ4_Output_Callback Output;   /**< Decoded byte sink */
+    LZ4_History_Callback History; /**< Access to earlier decoded bytes */
+    uint32_t Produced;            /**< Bytes output so far, bounds the match offsets */
+    uint32_t Block_Remaining;     /**< Bytes left in the current block */
+    uint32_t Length;              /**< Literal or match length being decoded */
+    uint32_t Value;               /**< Little-endian field being assembled */
+    uint16_t Offset;              /**< Offset of the current match */
+    uint8_t Count;                /**< Bytes left in the current field */
+    uint8_t Flags;                /**< Frame descriptor FLG byte */
+    uint8_t Token;                /**< Current sequence token */
+    uint8_t State;                /**< Decoder state */
+} LZ4_Context;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief Starts the decoding of an LZ4 frame.
+ *@param Context Pointer to the context to initialize.
+ *@param Output Callback receiving the decoded bytes.
+ *@param History Callback returning earlier decoded bytes.
+ */
+void LZ4_Init(LZ4_Context *Context, LZ4_Output_Callback Output, LZ4_History_Callback History);
+
+/*
+ *@brief Feeds one byte of the LZ4 frame.
+ *@param Context Pointer to the context.
+ *@param Data The next frame byte.
+ *@returns LZ4_BUSY, LZ4_DONE once the frame is complete, or LZ4_ERROR.
+ */
+LZ4_Status LZ4_Decode_Byte(LZ4_Context *Context, uint8_t Data);
+
+#endif /* INCLUDES_LZ4_H_ */
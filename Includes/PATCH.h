@@ -0,0 +1,95 @@
+/**
+ * @file PATCH.h
+ * @brief Header file for the delta patch decoder.
+ * @details This header file declares a byte-at-a-time decoder for delta patches, which rebuild a new image from the
+ *          installed one. The new image is produced from start to end by two commands: copy a run of bytes of the old
+ *          image, or insert bytes carried by the patch. Old bytes are read through a callback, so the old image can
+ *          stay in flash while the new one is programmed over it.
+ *
+ *          Patch format (little-endian, lengths and offsets as LEB128 varints):
+ *          - Magic PATCH_MAGIC (4 bytes, "DLT1")
+ *          - PATCH_OP_COPY, old offset, length: copy length bytes of the old image from old offset
+ *          - PATCH_OP_INSERT, length, then length bytes: insert the bytes
+ *          - PATCH_OP_END: the new image is complete
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+#ifndef INCLUDES_PATCH_H_
+#define INCLUDES_PATCH_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "MKL46Z4.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define PATCH_MAGIC 0x31544C44u /* "DLT1" in the stream */
+#define PATCH_OP_END 0x00u      /* End of the patch */
+#define PATCH_OP_COPY 0x01u     /* Copy from the old image */
+#define PATCH_OP_INSERT 0x02u   /* Insert new bytes */
+
+/*
+ *@brief Receives one byte of the new image.
+ */
+typedef void (*PATCH_Output_Callback)(uint8_t Data);
+
+/*
+ *@brief Returns the byte at the given offset of the old image.
+ */
+typedef uint8_t (*PATCH_Read_Old_Callback)(uint32_t Offset);
+
+/*
+ *@brief Result of feeding a byte to the decoder.
+ */
+typedef enum PATCH_Status
+{
+    PATCH_BUSY,  /* More input expected */
+    PATCH_DONE,  /* End command consumed */
+    PATCH_ERROR, /* Not a patch, unknown command or copy outside the old image */
+} PATCH_Status;
+
+/*
+ *@brief State of a streaming patch decoding.
+ */
+typedef struct PATCH_Context
+{
+    PATCH_Output_Callback Output;     /**< New image byte sink */
+    PATCH_Read_Old_Callback Read_Old; /**< Access to the old image */
+    uint32_t Old_Length;              /**< Length of the old image, bounds the copies */
+    uint32_t Old_Offset;              /**< Old offset of the current copy */
+    uint32_t Value;                   /**< Field being assembled */
+    uint8_t Shift;                    /**< Bit position of the next varint group */
+    uint8_t State;                    /**< Decoder state */
+} PATCH_Context;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief Starts the decoding of a patch.
+ *@param Context Pointer to the context to initialize.
+ *@param Output Callback receiving the new image bytes.
+ *@param Read_Old Callback returning old image bytes.
+ *@param Old_Length Length of the old image.
+ */
+void PATCH_Init(PATCH_Context *Context, PATCH_Output_Callback Output, PATCH_Read_Old_Callback Read_Old,
+                uint32_t Old_Length);
+
+/*
+ *@brief Feeds one byte of the patch.
+ *@param Context Pointer to the context.
+ *@param Data The next patch byte.
+ *@returns PATCH_BUSY, PATCH_DONE once the patch is complete, or PATCH_ERROR.
+ */
+PATCH_Status PATCH_Decode_Byte(PATCH_Context *Context, uint8_t Data);
+
+#endif /* INCLUDES_PATCH_H_ */
@@ -24,7 +24,8 @@
  * Definitions
  ******************************************************************************/
 
-#define NUMBER_OF_QUEUES 4 /* NUMBER OF QUEUES */
+#define NUMBER_OF_QUEUES 8 /* NUMBER OF QUEUES */
+#define QUEUE_STATE_HELD 2 /* Frame received ahead of a missing one, processed once the missing one arrives */
 
 /*
  * @brief Represents a queue element.
@@ -34,6 +35,7 @@ typedef struct
 {
     char record[MAX_LINE_LENGTH_RECORD]; /**< Buffer to store the record data */
     uint8_t state;                       /**< State indicator for the queue element */
+    uint32_t number;                     /**< Arrival number of an S-record line, from 0 */
 } Queue;
 
 /*******************************************************************************
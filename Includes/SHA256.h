@@ -0,0 +1,66 @@
+/**
+ * @file SHA256.h
+ * @brief Header file for the SHA-256 engine.
+ * @details This header file declares a streaming SHA-256 (FIPS 180-4) used to confirm that the image received by the
+ *          bootloader is exactly the image produced by the build server. The context is fed incrementally, so the
+ *          digest is ready as soon as the last record has been decoded.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+#ifndef INCLUDES_SHA256_H_
+#define INCLUDES_SHA256_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "MKL46Z4.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SHA256_DIGEST_SIZE 32u /* Digest length in bytes */
+#define SHA256_BLOCK_SIZE 64u  /* Compression block length in bytes */
+
+/*
+ *@brief Streaming SHA-256 context.
+ */
+typedef struct SHA256_Context
+{
+    uint32_t State[8];                 /**< Intermediate hash value */
+    uint32_t Length;                   /**< Number of bytes fed so far */
+    uint8_t Block[SHA256_BLOCK_SIZE];  /**< Bytes waiting for a full block */
+    uint8_t Block_Used;                /**< Number of bytes in Block */
+} SHA256_Context;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief Starts a SHA-256 computation.
+ *@param Context Pointer to the context to initialize.
+ */
+void SHA256_Init(SHA256_Context *Context);
+
+/*
+ *@brief Feeds data into a SHA-256 computation.
+ *@param Context Pointer to the context.
+ *@param Data Pointer to the data, in RAM or memory-mapped flash.
+ *@param Length Number of bytes.
+ */
+void SHA256_Update(SHA256_Context *Context, const uint8_t *Data, uint32_t Length);
+
+/*
+ *@brief Finishes a SHA-256 computation.
+ *@param Context Pointer to the context; it must be initialized again before reuse.
+ *@param Digest Buffer receiving the SHA256_DIGEST_SIZE byte digest.
+ */
+void SHA256_Final(SHA256_Context *Context, uint8_t *Digest);
+
+#endif /* INCLUDES_SHA256_H_ */
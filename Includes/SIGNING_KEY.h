@@ -0,0 +1,30 @@
+/**
+ * @file SIGNING_KEY.h
+ * @brief Public key used to verify signed application images.
+ * @details This header file holds the ECDSA P-256 public key (X || Y, big-endian) that signed images are checked
+ *          against. The key below is a development key; replace it with the production key before release.
+ *          Images are signed over the SHA-256 of the image bytes, e.g. with
+ *          `openssl dgst -sha256 -sign key.pem image.bin`, where image.bin is the application image with gaps
+ *          filled with 0xFF.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+#ifndef INCLUDES_SIGNING_KEY_H_
+#define INCLUDES_SIGNING_KEY_H_
+
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SIGNING_KEY_PUBLIC_KEY \
+    { \
+        0x9E, 0xB0, 0xBB, 0x51, 0xAC, 0x7F, 0x48, 0x14, 0x2A, 0x82, 0x8E, 0xF1, 0x3A, 0xF2, 0xDD, 0xF0, \
+        0x35, 0x31, 0xCF, 0x55, 0xF3, 0x95, 0x6A, 0x22, 0x61, 0x73, 0x55, 0xB3, 0x5F, 0x09, 0x0D, 0x24, \
+        0x23, 0x8D, 0x51, 0x8F, 0xDC, 0x97, 0x52, 0x27, 0xCB, 0xDD, 0x33, 0xB7, 0x15, 0x13, 0xF4, 0x11, \
+        0xCF, 0xEE, 0xD7, 0xAD, 0x49, 0x28, 0x64, 0x8E, 0xD2, 0x67, 0x29, 0xBA, 0xE5, 0x84, 0x9B, 0x8D \
+    }
+
+#endif /* INCLUDES_SIGNING_KEY_H_ */
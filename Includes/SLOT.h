@@ -0,0 +1,121 @@
+/**
+ * @file SLOT.h
+ * @brief Header file for the application slot selection.
+ * @details This header file declares the metadata that selects which of the two application slots boots (see IMAGE.h).
+ *          An update is written into the inactive slot and only becomes the active one once it has been received
+ *          and verified, so a failed update leaves the running image untouched.
+ *
+ *          The metadata is a log of words appended to the erased words of a metadata sector; the state is given by
+ *          replaying it. SLOT_WORD_TRIAL selects a slot on trial: each boot of it appends SLOT_WORD_ATTEMPT, and the
+ *          application appends SLOT_WORD_CONFIRM, into the first erased word of the current log, once it runs
+ *          correctly. A trial slot booted SLOT_BOOT_ATTEMPTS times without a confirmation is rolled back by appending
+ *          SLOT_WORD_SELECT for the other slot, a single flash word. No valid log selects slot A.
+ *
+ *          The two metadata sectors, directly below the journal sector, are used in turn (see SLOT_Metadata): the
+ *          current log is the valid one with the highest sequence, so the state always survives a power loss.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+#ifndef INCLUDES_SLOT_H_
+#define INCLUDES_SLOT_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "MKL46Z4.h"
+#include "IMAGE.h"
+#include "JOURNAL.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SLOT_METADATA_SECTORS 2u                                     /* Used in turn, see SLOT_Metadata */
+#define SLOT_METADATA_ADDRESS (JOURNAL_ADDRESS - SLOT_METADATA_SECTORS * IMAGE_SECTOR_SIZE) /* Below the journal sector */
+#define SLOT_METADATA_MAGIC 0x31544C53u                              /* "SLT1" in memory, programmed once the log verified */
+#define SLOT_WORDS ((IMAGE_SECTOR_SIZE / 4u) - 3u)                   /* Log words in a metadata sector */
+#define SLOT_A 0u                                                    /* Slot at APPLICATION_ADDRESS */
+#define SLOT_B 1u                                                    /* Slot IMAGE_SLOT_STRIDE above it */
+#define SLOT_NONE 0xFFu                                              /* No confirmed slot */
+#define SLOT_OTHER(Slot) (SLOT_B - (Slot))                           /* The slot an update of Slot goes to */
+#define SLOT_WORD_TRIAL 0x4C525400u                                  /* "\0TRL" + slot in the low byte: new image on trial */
+#define SLOT_WORD_SELECT 0x4C455300u                                 /* "\0SEL" + slot in the low byte: confirmed selection */
+#define SLOT_WORD_ATTEMPT 0x544F4F42u                                /* "BOOT": the trial slot was started once more */
+#define SLOT_WORD_CONFIRM 0x444F4F47u                                /* "GOOD": programmed by the application on trial */
+
+/*
+ *@brief Boots of a slot on trial before it is rolled back without a confirmation.
+ */
+#ifndef SLOT_BOOT_ATTEMPTS
+#define SLOT_BOOT_ATTEMPTS 3u
+#endif
+
+#if (IMAGE_SLOT_COUNT != 2u)
+#error "The slot metadata selects between slot A and slot B"
+#endif
+
+#if (IMAGE_BOOT_LOG_ADDRESS + IMAGE_BOOT_LOG_SECTORS * IMAGE_SECTOR_SIZE > SLOT_METADATA_ADDRESS)
+#error "The boot configuration and boot log sectors must lie below the slot metadata sector"
+#endif
+
+/*
+ *@brief Layout of a metadata sector.
+ *@details When the current log is full, a new one is started in the other sector: it is erased, given the next
+ *         Sequence and the words of the current state, read back, and only then marked valid with Magic. The old
+ *         sector is erased after that. A power loss at any point leaves one valid log holding the state. Sequence
+ *         is stored with its complement, so a log whose erase was interrupted is not taken for the current one.
+ */
+typedef struct SLOT_Metadata
+{
+    uint32_t Sequence;          /**< One more than the sequence of the log it replaced */
+    uint32_t Sequence_Check;    /**< ~Sequence */
+    uint32_t Magic;             /**< SLOT_METADATA_MAGIC once the log is valid */
+    uint32_t Words[SLOT_WORDS]; /**< Log words, 0xFFFFFFFF if unused */
+} SLOT_Metadata;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief Returns the slot selected by the metadata.
+ *@returns SLOT_A or SLOT_B.
+ */
+uint8_t SLOT_Active(void);
+
+/*
+ *@brief Returns the selected slot if the application there confirmed it.
+ *@details Only reads the metadata and uses no static data, so it can run before the C runtime init.
+ *@returns SLOT_A or SLOT_B, or SLOT_NONE while a slot is on trial.
+ */
+uint8_t SLOT_Confirmed(void);
+
+/*
+ *@brief Chooses the slot to boot and records the boot attempt.
+ *@details A slot on trial gets a SLOT_WORD_ATTEMPT, or is rolled back once it used up its SLOT_BOOT_ATTEMPTS.
+ *         Interrupts are disabled while the metadata is programmed.
+ *@returns SLOT_A or SLOT_B.
+ */
+uint8_t SLOT_Boot(void);
+
+/*
+ *@brief Selects a slot for good.
+ *@details Used when the selected slot holds no startable image and the other one does. Interrupts are disabled
+ *         while the metadata is programmed.
+ *@param Slot SLOT_A or SLOT_B.
+ */
+void SLOT_Select(uint8_t Slot);
+
+/*
+ *@brief Puts a slot on trial.
+ *@details Called once the update of the slot is committed. Interrupts must be disabled by the caller.
+ *@param Slot SLOT_A or SLOT_B.
+ */
+void SLOT_Activate(uint8_t Slot);
+
+#endif /* INCLUDES_SLOT_H_ */
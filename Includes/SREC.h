@@ -68,6 +68,13 @@ uint8_t hexCharToByte(char c);
  */
 uint8_t Check_Line_Record(volatile char *srec_line);
 
+/*
+ *@brief Returns the number of address bytes of an SREC record.
+ *@param record Pointer to the SREC record.
+ *@returns 3 for S2 and S8 records, 4 for S3 and S7 records, 2 otherwise.
+ */
+uint8_t record_address_size(volatile char *record);
+
 /*
  *@brief Parses an SREC record and fills the Record structure.
  *@param record Pointer to the SREC record.
@@ -76,4 +83,15 @@ uint8_t Check_Line_Record(volatile char *srec_line);
  */
 void record_parser(volatile char *record, Record *record_struct, uint8_t byteCount_of_data);
 
+/*
+ *@brief Decodes the whole data field of an SREC record.
+ *@details Unlike record_parser, the number of data bytes is not limited to 16, so records carrying more than
+ *         16 bytes, such as the image digest record, can be decoded.
+ *@param record Pointer to the SREC record.
+ *@param data Buffer receiving the data bytes, at least byteCount_in_record - 3 bytes long (S1 records).
+ *@param byteCount_in_record The byte count in the record.
+ *@returns The number of data bytes decoded.
+ */
+uint8_t record_data_parser(volatile char *record, uint8_t *data, uint8_t byteCount_in_record);
+
 #endif /* INCLUDES_SREC_H_ */
@@ -0,0 +1,89 @@
+/**
+ * @file TIMESTAMP.h
+ * @brief Header file for the boot timestamps.
+ * @details This header file declares the table of boot milestones, timed with SysTick from the entry of
+ *          Reset_Handler. SysTick runs free from the core clock after reset, and TIMESTAMP_Now() extends its 24-bit
+ *          count, so it must be called at least once per SysTick period (0.8 s at 20.97 MHz) while the ticks are used.
+ *
+ *          The table lies in m_noinit at TIMESTAMP_ADDRESS, so the application can read it after the jump: the ticks
+ *          of TIMESTAMP_JUMP are the share of the bootloader in the boot time, the time from power-on to the entry
+ *          of Reset_Handler excepted. Reset_Handler keeps the table of the previous boot at TIMESTAMP_PREVIOUS_ADDRESS,
+ *          which bootloader mode prints over UART0. A milestone not reached holds TIMESTAMP_NONE.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+#ifndef INCLUDES_TIMESTAMP_H_
+#define INCLUDES_TIMESTAMP_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "MKL46Z4.h"
+#include "BOOT.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define TIMESTAMP_MAIN 0u           /* main() entered, C runtime initialized */
+#define TIMESTAMP_PERIPHERALS 1u    /* UART0, LEDs and SW2 initialized */
+#define TIMESTAMP_BOOT_MODE 2u      /* Update request, SW2 and sync window read */
+#define TIMESTAMP_IMAGE_CHECKED 3u  /* Slot to boot chosen and its image checked */
+#define TIMESTAMP_JUMP 4u           /* Peripherals de-initialized, jumping to the application */
+#define TIMESTAMP_UPDATE_MODE 5u    /* Bootloader mode entered instead */
+#define TIMESTAMP_COUNT 6u          /* Milestones in a table */
+#define TIMESTAMP_NONE 0xFFFFFFFFu  /* Milestone not reached */
+#define TIMESTAMP_MAGIC 0x454D4954u /* "TIME" in memory: the table was started by Reset_Handler */
+#define TIMESTAMP_TABLE_SIZE 0x40u  /* Room for one table in m_noinit */
+#define TIMESTAMP_ADDRESS (BOOT_NOINIT_ADDRESS + TIMESTAMP_TABLE_SIZE)               /* Table of this boot */
+#define TIMESTAMP_PREVIOUS_ADDRESS (TIMESTAMP_ADDRESS + TIMESTAMP_TABLE_SIZE)         /* Table of the previous boot */
+
+#if ((4u + TIMESTAMP_COUNT) * 4u > TIMESTAMP_TABLE_SIZE)
+#error "The milestones do not fit in TIMESTAMP_TABLE_SIZE"
+#endif
+
+#if (TIMESTAMP_PREVIOUS_ADDRESS + TIMESTAMP_TABLE_SIZE > BOOT_NOINIT_ADDRESS + BOOT_NOINIT_SIZE)
+#error "The timestamp tables do not fit in m_noinit"
+#endif
+
+/*
+ *@brief Boot milestones of one boot.
+ */
+typedef struct TIMESTAMP_Table
+{
+    uint32_t Magic;                   /**< TIMESTAMP_MAGIC */
+    uint32_t Clock_Hz;                /**< SysTick clock, the core clock after reset */
+    uint32_t Now;                     /**< Ticks since the entry of Reset_Handler at the last read of SysTick */
+    uint32_t Last;                    /**< SysTick VAL at the last read */
+    uint32_t Ticks[TIMESTAMP_COUNT];  /**< Ticks since the entry of Reset_Handler of each milestone */
+} TIMESTAMP_Table;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief Starts SysTick and a new table.
+ *@details Called first thing by Reset_Handler, before SystemInit and the C runtime init: it only uses the stack and
+ *         m_noinit. A valid table left by the previous boot is copied to TIMESTAMP_PREVIOUS_ADDRESS.
+ */
+void TIMESTAMP_Start(void);
+
+/*
+ *@brief Returns the ticks since the entry of Reset_Handler.
+ *@returns The ticks of the core clock after reset.
+ */
+uint32_t TIMESTAMP_Now(void);
+
+/*
+ *@brief Records the time of a milestone.
+ *@param Milestone TIMESTAMP_MAIN to TIMESTAMP_UPDATE_MODE.
+ */
+void TIMESTAMP_Record(uint8_t Milestone);
+
+#endif /* INCLUDES_TIMESTAMP_H_ */
@@ -0,0 +1,98 @@
+/**
+ * @file YMODEM.h
+ * @brief Header file for the XMODEM-1K / YMODEM block receiver.
+ * @details This header file declares a byte-at-a-time receiver for the blocks of the XMODEM-1K and YMODEM protocols
+ *          with CRC16, as sent by stock terminal programs. The receiver checks the framing, the block number
+ *          complement and the CRC of each block; the caller answers with YMODEM_ACK or YMODEM_NAK and decides what
+ *          the block numbers mean.
+ *
+ *          Block layout: YMODEM_SOH (128 data bytes) or YMODEM_STX (1024 data bytes), block number, its complement,
+ *          data, CRC-16/XMODEM of the data (high byte first). A YMODEM transfer starts with block 0, which carries the
+ *          file name and size; an XMODEM-1K transfer starts with block 1. YMODEM_EOT ends a file, and a YMODEM block 0
+ *          with an empty file name ends the batch.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+#ifndef INCLUDES_YMODEM_H_
+#define INCLUDES_YMODEM_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "MKL46Z4.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define YMODEM_SOH 0x01u              /* Start of a 128-byte block */
+#define YMODEM_STX 0x02u              /* Start of a 1024-byte block */
+#define YMODEM_EOT 0x04u              /* End of the file */
+#define YMODEM_ACK 0x06u              /* Block accepted */
+#define YMODEM_NAK 0x15u              /* Block rejected, send it again */
+#define YMODEM_CAN 0x18u              /* Transfer cancelled */
+#define YMODEM_CRC_REQUEST 'C'        /* Receiver request for CRC16 blocks, starts a transfer */
+#define YMODEM_SUB 0x1Au              /* Padding of the last block of a file */
+#define YMODEM_BLOCK_SIZE 128u        /* Data bytes of a YMODEM_SOH block */
+#define YMODEM_BLOCK_1K_SIZE 1024u    /* Data bytes of a YMODEM_STX block, one flash sector */
+#define YMODEM_SIZE_UNKNOWN 0xFFFFFFFFu /* File size of an XMODEM-1K transfer, or of a header without size */
+
+/*
+ *@brief Result of feeding a byte to the receiver.
+ */
+typedef enum YMODEM_Status
+{
+    YMODEM_BUSY,   /* More input expected */
+    YMODEM_BLOCK,  /* A valid block is in Data, Number and Length */
+    YMODEM_END,    /* YMODEM_EOT received */
+    YMODEM_CANCEL, /* YMODEM_CAN received */
+    YMODEM_ERROR,  /* Corrupted block, the sender must send it again */
+} YMODEM_Status;
+
+/*
+ *@brief State of the block receiver.
+ */
+typedef struct YMODEM_Context
+{
+    uint8_t Data[YMODEM_BLOCK_1K_SIZE]; /**< Data of the current block */
+    uint16_t Length;                    /**< Data bytes of the current block */
+    uint16_t Index;                     /**< Data bytes received so far */
+    uint16_t CRC;                       /**< CRC read from the block */
+    uint8_t Number;                     /**< Block number */
+    uint8_t State;                      /**< Receiver state */
+} YMODEM_Context;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief Prepares the receiver for the start of a block.
+ *@param Context Pointer to the context to initialize.
+ */
+void YMODEM_Init(YMODEM_Context *Context);
+
+/*
+ *@brief Feeds one received byte.
+ *@details Bytes other than a block start, YMODEM_EOT or YMODEM_CAN are ignored between blocks. After YMODEM_BLOCK,
+ *         YMODEM_ERROR, YMODEM_END or YMODEM_CANCEL the receiver waits for the next block.
+ *@param Context Pointer to the context.
+ *@param Data The received byte.
+ *@returns YMODEM_BUSY, YMODEM_BLOCK, YMODEM_END, YMODEM_CANCEL or YMODEM_ERROR.
+ */
+YMODEM_Status YMODEM_Receive_Byte(YMODEM_Context *Context, uint8_t Data);
+
+/*
+ *@brief Reads the file size from a YMODEM block 0.
+ *@details Block 0 holds the file name, a NUL byte, then the size in decimal followed by a space or a NUL byte.
+ *@param Context Pointer to the context holding block 0.
+ *@returns The file size, or YMODEM_SIZE_UNKNOWN if the block carries none.
+ */
+uint32_t YMODEM_File_Size(const YMODEM_Context *Context);
+
+#endif /* INCLUDES_YMODEM_H_ */
@@ -0,0 +1,294 @@
+/**
+ * @file AES128.c
+ * @brief AES-128 block cipher (encryption only).
+ * @details This file contains a table-based AES-128 encryption sized for the Cortex-M0+. A single 1 KB T-table
+ *          combines SubBytes and MixColumns; the three other column tables of the classic implementation are
+ *          replaced by rotations, which the core executes in one cycle, to save 3 KB of flash. The S-box is used
+ *          for the key expansion and the last round. The CTR key stream used for the image decryption is computed
+ *          one block per 16 bytes of data.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "AES128.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define AES128_ROTR(x, n) (((x) >> (n)) | ((x) << (32u - (n))))
+#define AES128_TE0(x) (AES128_Te0[(x) & 0xFFu])
+#define AES128_TE1(x) AES128_ROTR(AES128_Te0[(x) & 0xFFu], 8u)
+#define AES128_TE2(x) AES128_ROTR(AES128_Te0[(x) & 0xFFu], 16u)
+#define AES128_TE3(x) AES128_ROTR(AES128_Te0[(x) & 0xFFu], 24u)
+#define AES128_SUB(x, shift) ((uint32_t)AES128_Sbox[((x) >> (shift)) & 0xFFu] << (shift))
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*
+ *@brief AES S-box.
+ */
+static const uint8_t AES128_Sbox[256] = {
+    0x63, 0x7C, 0x77, 0x7B, 0xF2, 0x6B, 0x6F, 0xC5, 0x30, 0x01, 0x67, 0x2B, 0xFE, 0xD7, 0xAB, 0x76,
+    0xCA, 0x82, 0xC9, 0x7D, 0xFA, 0x59, 0x47, 0xF0, 0xAD, 0xD4, 0xA2, 0xAF, 0x9C, 0xA4, 0x72, 0xC0,
+    0xB7, 0xFD, 0x93, 0x26, 0x36, 0x3F, 0xF7, 0xCC, 0x34, 0xA5, 0xE5, 0xF1, 0x71, 0xD8, 0x31, 0x15,
+    0x04, 0xC7, 0x23, 0xC3, 0x18, 0x96, 0x05, 0x9A, 0x07, 0x12, 0x80, 0xE2, 0xEB, 0x27, 0xB2, 0x75,
+    0x09, 0x83, 0x2C, 0x1A, 0x1B, 0x6E, 0x5A, 0xA0, 0x52, 0x3B, 0xD6, 0xB3, 0x29, 0xE3, 0x2F, 0x84,
+    0x53, 0xD1, 0x00, 0xED, 0x20, 0xFC, 0xB1, 0x5B, 0x6A, 0xCB, 0xBE, 0x39, 0x4A, 0x4C, 0x58, 0xCF,
+    0xD0, 0xEF, 0xAA, 0xFB, 0x43, 0x4D, 0x33, 0x85, 0x45, 0xF9, 0x02, 0x7F, 0x50, 0x3C, 0x9F, 0xA8,
+    0x51, 0xA3, 0x40, 0x8F, 0x92, 0x9D, 0x38, 0xF5, 0xBC, 0xB6, 0xDA, 0x21, 0x10, 0xFF, 0xF3, 0xD2,
+    0xCD, 0x0C, 0x13, 0xEC, 0x5F, 0x97, 0x44, 0x17, 0xC4, 0xA7, 0x7E, 0x3D, 0x64, 0x5D, 0x19, 0x73,
+    0x60, 0x81, 0x4F, 0xDC, 0x22, 0x2A, 0x90, 0x88, 0x46, 0xEE, 0xB8, 0x14, 0xDE, 0x5E, 0x0B, 0xDB,
+    0xE0, 0x32, 0x3A, 0x0A, 0x49, 0x06, 0x24, 0x5C, 0xC2, 0xD3, 0xAC, 0x62, 0x91, 0x95, 0xE4, 0x79,
+    0xE7, 0xC8, 0x37, 0x6D, 0x8D, 0xD5, 0x4E, 0xA9, 0x6C, 0x56, 0xF4, 0xEA, 0x65, 0x7A, 0xAE, 0x08,
+    0xBA, 0x78, 0x25, 0x2E, 0x1C, 0xA6, 0xB4, 0xC6, 0xE8, 0xDD, 0x74, 0x1F, 0x4B, 0xBD, 0x8B, 0x8A,
+    0x70, 0x3E, 0xB5, 0x66, 0x48, 0x03, 0xF6, 0x0E, 0x61, 0x35, 0x57, 0xB9, 0x86, 0xC1, 0x1D, 0x9E,
+    0xE1, 0xF8, 0x98, 0x11, 0x69, 0xD9, 0x8E, 0x94, 0x9B, 0x1E, 0x87, 0xE9, 0xCE, 0x55, 0x28, 0xDF,
+    0x8C, 0xA1, 0x89, 0x0D, 0xBF, 0xE6, 0x42, 0x68, 0x41, 0x99, 0x2D, 0x0F, 0xB0, 0x54, 0xBB, 0x16};
+
+/*
+ *@brief SubBytes and MixColumns table: 2*S[x] << 24 | S[x] << 16 | S[x] << 8 | 3*S[x].
+ */
+static const uint32_t AES128_Te0[256] = {
+    0xC66363A5u, 0xF87C7C84u, 0xEE777799u, 0xF67B7B8Du, 0xFFF2F20Du, 0xD66B6BBDu,
+    0xDE6F6FB1u, 0x91C5C554u, 0x60303050u, 0x02010103u, 0xCE6767A9u, 0x562B2B7Du,
+    0xE7FEFE19u, 0xB5D7D762u, 0x4DABABE6u, 0xEC76769Au, 0x8FCACA45u, 0x1F82829Du,
+    0x89C9C940u, 0xFA7D7D87u, 0xEFFAFA15u, 0xB25959EBu, 0x8E4747C9u, 0xFBF0F00Bu,
+    0x41ADADECu, 0xB3D4D467u, 0x5FA2A2FDu, 0x45AFAFEAu, 0x239C9CBFu, 0x53A4A4F7u,
+    0xE4727296u, 0x9BC0C05Bu, 0x75B7B7C2u, 0xE1FDFD1Cu, 0x3D9393AEu, 0x4C26266Au,
+    0x6C36365Au, 0x7E3F3F41u, 0xF5F7F702u, 0x83CCCC4Fu, 0x6834345Cu, 0x51A5A5F4u,
+    0xD1E5E534u, 0xF9F1F108u, 0xE2717193u, 0xABD8D873u, 0x62313153u, 0x2A15153Fu,
+    0x0804040Cu, 0x95C7C752u, 0x46232365u, 0x9DC3C35Eu, 0x30181828u, 0x379696A1u,
+    0x0A05050Fu, 0x2F9A9AB5u, 0x0E070709u, 0x24121236u, 0x1B80809Bu, 0xDFE2E23Du,
+    0xCDEBEB26u, 0x4E272769u, 0x7FB2B2CDu, 0xEA75759Fu, 0x1209091Bu, 0x1D83839Eu,
+    0x582C2C74u, 0x341A1A2Eu, 0x361B1B2Du, 0xDC6E6EB2u, 0xB45A5AEEu, 0x5BA0A0FBu,
+    0xA45252F6u, 0x763B3B4Du, 0xB7D6D661u, 0x7DB3B3CEu, 0x5229297Bu, 0xDDE3E33Eu,
+    0x5E2F2F71u, 0x13848497u, 0xA65353F5u, 0xB9D1D168u, 0x00000000u, 0xC1EDED2Cu,
+    0x40202060u, 0xE3FCFC1Fu, 0x79B1B1C8u, 0xB65B5BEDu, 0xD46A6ABEu, 0x8DCBCB46u,
+    0x67BEBED9u, 0x7239394Bu, 0x944A4ADEu, 0x984C4CD4u, 0xB05858E8u, 0x85CFCF4Au,
+    0xBBD0D06Bu, 0xC5EFEF2Au, 0x4FAAAAE5u, 0xEDFBFB16u, 0x864343C5u, 0x9A4D4DD7u,
+    0x66333355u, 0x11858594u, 0x8A4545CFu, 0xE9F9F910u, 0x04020206u, 0xFE7F7F81u,
+    0xA05050F0u, 0x783C3C44u, 0x259F9FBAu, 0x4BA8A8E3u, 0xA25151F3u, 0x5DA3A3FEu,
+    0x804040C0u, 0x058F8F8Au, 0x3F9292ADu, 0x219D9DBCu, 0x70383848u, 0xF1F5F504u,
+    0x63BCBCDFu, 0x77B6B6C1u, 0xAFDADA75u, 0x42212163u, 0x20101030u, 0xE5FFFF1Au,
+    0xFDF3F30Eu, 0xBFD2D26Du, 0x81CDCD4Cu, 0x180C0C14u, 0x26131335u, 0xC3ECEC2Fu,
+    0xBE5F5FE1u, 0x359797A2u, 0x884444CCu, 0x2E171739u, 0x93C4C457u, 0x55A7A7F2u,
+    0xFC7E7E82u, 0x7A3D3D47u, 0xC86464ACu, 0xBA5D5DE7u, 0x3219192Bu, 0xE6737395u,
+    0xC06060A0u, 0x19818198u, 0x9E4F4FD1u, 0xA3DCDC7Fu, 0x44222266u, 0x542A2A7Eu,
+    0x3B9090ABu, 0x0B888883u, 0x8C4646CAu, 0xC7EEEE29u, 0x6BB8B8D3u, 0x2814143Cu,
+    0xA7DEDE79u, 0xBC5E5EE2u, 0x160B0B1Du, 0xADDBDB76u, 0xDBE0E03Bu, 0x64323256u,
+    0x743A3A4Eu, 0x140A0A1Eu, 0x924949DBu, 0x0C06060Au, 0x4824246Cu, 0xB85C5CE4u,
+    0x9FC2C25Du, 0xBDD3D36Eu, 0x43ACACEFu, 0xC46262A6u, 0x399191A8u, 0x319595A4u,
+    0xD3E4E437u, 0xF279798Bu, 0xD5E7E732u, 0x8BC8C843u, 0x6E373759u, 0xDA6D6DB7u,
+    0x018D8D8Cu, 0xB1D5D564u, 0x9C4E4ED2u, 0x49A9A9E0u, 0xD86C6CB4u, 0xAC5656FAu,
+    0xF3F4F407u, 0xCFEAEA25u, 0xCA6565AFu, 0xF47A7A8Eu, 0x47AEAEE9u, 0x10080818u,
+    0x6FBABAD5u, 0xF0787888u, 0x4A25256Fu, 0x5C2E2E72u, 0x381C1C24u, 0x57A6A6F1u,
+    0x73B4B4C7u, 0x97C6C651u, 0xCBE8E823u, 0xA1DDDD7Cu, 0xE874749Cu, 0x3E1F1F21u,
+    0x964B4BDDu, 0x61BDBDDCu, 0x0D8B8B86u, 0x0F8A8A85u, 0xE0707090u, 0x7C3E3E42u,
+    0x71B5B5C4u, 0xCC6666AAu, 0x904848D8u, 0x06030305u, 0xF7F6F601u, 0x1C0E0E12u,
+    0xC26161A3u, 0x6A35355Fu, 0xAE5757F9u, 0x69B9B9D0u, 0x17868691u, 0x99C1C158u,
+    0x3A1D1D27u, 0x279E9EB9u, 0xD9E1E138u, 0xEBF8F813u, 0x2B9898B3u, 0x22111133u,
+    0xD26969BBu, 0xA9D9D970u, 0x078E8E89u, 0x339494A7u, 0x2D9B9BB6u, 0x3C1E1E22u,
+    0x15878792u, 0xC9E9E920u, 0x87CECE49u, 0xAA5555FFu, 0x50282878u, 0xA5DFDF7Au,
+    0x038C8C8Fu, 0x59A1A1F8u, 0x09898980u, 0x1A0D0D17u, 0x65BFBFDAu, 0xD7E6E631u,
+    0x844242C6u, 0xD06868B8u, 0x824141C3u, 0x299999B0u, 0x5A2D2D77u, 0x1E0F0F11u,
+    0x7BB0B0CBu, 0xA85454FCu, 0x6DBBBBD6u, 0x2C16163Au};
+
+/*
+ *@brief Key expansion round constants.
+ */
+static const uint8_t AES128_Rcon[AES128_ROUNDS] = {0x01, 0x02, 0x04, 0x08, 0x10, 0x20, 0x40, 0x80, 0x1B, 0x36};
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief Loads four big-endian bytes.
+ */
+static uint32_t AES128_Load(const uint8_t *Data);
+
+/*
+ *@brief Stores a word as four big-endian bytes.
+ */
+static void AES128_Store(uint8_t *Data, uint32_t Word);
+
+/*
+ *@brief Computes the key stream block of the given offset / 16.
+ *@param Context Pointer to the key stream.
+ *@param Index Block index.
+ */
+static void AES128_CTR_Block(AES128_CTR_Context *Context, uint32_t Index);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *@brief Loads four big-endian bytes.
+ */
+static uint32_t AES128_Load(const uint8_t *Data)
+{
+    return ((uint32_t)Data[0] << 24) | ((uint32_t)Data[1] << 16) | ((uint32_t)Data[2] << 8) | (uint32_t)Data[3];
+}
+
+/*
+ *@brief Stores a word as four big-endian bytes.
+ */
+static void AES128_Store(uint8_t *Data, uint32_t Word)
+{
+    Data[0] = (uint8_t)(Word >> 24);
+    Data[1] = (uint8_t)(Word >> 16);
+    Data[2] = (uint8_t)(Word >> 8);
+    Data[3] = (uint8_t)Word;
+}
+
+/*
+ *@brief Expands an AES-128 key.
+ *@param Context Pointer to the context receiving the round keys.
+ *@param Key Pointer to the AES128_KEY_SIZE byte key.
+ */
+void AES128_Init(AES128_Context *Context, const uint8_t *Key)
+{
+    uint32_t *rk = Context->Round_Key;
+    uint32_t t = 0;
+    uint8_t i = 0;
+
+    for (i = 0; i < 4u; i++)
+    {
+        rk[i] = AES128_Load(&Key[4u * i]);
+    }
+    for (i = 4; i < 4u * (AES128_ROUNDS + 1u); i++)
+    {
+        t = rk[i - 1u];
+        if (0 == (i & 3u))
+        {
+            /* RotWord, SubWord and Rcon */
+            t = AES128_SUB(t, 16u) << 8 | AES128_SUB(t, 8u) << 8 | AES128_SUB(t, 0u) << 8 | AES128_SUB(t, 24u) >> 24;
+            t ^= (uint32_t)AES128_Rcon[(i >> 2) - 1u] << 24;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        rk[i] = rk[i - 4u] ^ t;
+    }
+}
+
+/*
+ *@brief Encrypts one block.
+ *@param Context Pointer to the expanded key.
+ *@param Input Pointer to the AES128_BLOCK_SIZE byte plaintext.
+ *@param Output Pointer to the AES128_BLOCK_SIZE byte ciphertext; may be the same as Input.
+ */
+void AES128_Encrypt_Block(const AES128_Context *Context, const uint8_t *Input, uint8_t *Output)
+{
+    const uint32_t *rk = Context->Round_Key;
+    uint32_t s0 = AES128_Load(&Input[0]) ^ rk[0];
+    uint32_t s1 = AES128_Load(&Input[4]) ^ rk[1];
+    uint32_t s2 = AES128_Load(&Input[8]) ^ rk[2];
+    uint32_t s3 = AES128_Load(&Input[12]) ^ rk[3];
+    uint32_t t0 = 0;
+    uint32_t t1 = 0;
+    uint32_t t2 = 0;
+    uint32_t t3 = 0;
+    uint8_t round = 0;
+
+    for (round = 1; round < AES128_ROUNDS; round++)
+    {
+        rk += 4;
+        t0 = AES128_TE0(s0 >> 24) ^ AES128_TE1(s1 >> 16) ^ AES128_TE2(s2 >> 8) ^ AES128_TE3(s3) ^ rk[0];
+        t1 = AES128_TE0(s1 >> 24) ^ AES128_TE1(s2 >> 16) ^ AES128_TE2(s3 >> 8) ^ AES128_TE3(s0) ^ rk[1];
+        t2 = AES128_TE0(s2 >> 24) ^ AES128_TE1(s3 >> 16) ^ AES128_TE2(s0 >> 8) ^ AES128_TE3(s1) ^ rk[2];
+        t3 = AES128_TE0(s3 >> 24) ^ AES128_TE1(s0 >> 16) ^ AES128_TE2(s1 >> 8) ^ AES128_TE3(s2) ^ rk[3];
+        s0 = t0;
+        s1 = t1;
+        s2 = t2;
+        s3 = t3;
+    }
+
+    /* Last round: SubBytes and ShiftRows only */
+    rk += 4;
+    t0 = AES128_SUB(s0, 24u) ^ AES128_SUB(s1, 16u) ^ AES128_SUB(s2, 8u) ^ AES128_SUB(s3, 0u) ^ rk[0];
+    t1 = AES128_SUB(s1, 24u) ^ AES128_SUB(s2, 16u) ^ AES128_SUB(s3, 8u) ^ AES128_SUB(s0, 0u) ^ rk[1];
+    t2 = AES128_SUB(s2, 24u) ^ AES128_SUB(s3, 16u) ^ AES128_SUB(s0, 8u) ^ AES128_SUB(s1, 0u) ^ rk[2];
+    t3 = AES128_SUB(s3, 24u) ^ AES128_SUB(s0, 16u) ^ AES128_SUB(s1, 8u) ^ AES128_SUB(s2, 0u) ^ rk[3];
+    AES128_Store(&Output[0], t0);
+    AES128_Store(&Output[4], t1);
+    AES128_Store(&Output[8], t2);
+    AES128_Store(&Output[12], t3);
+}
+
+/*
+ *@brief Computes the key stream block of the given offset / 16.
+ *@param Context Pointer to the key stream.
+ *@param Index Block index.
+ */
+static void AES128_CTR_Block(AES128_CTR_Context *Context, uint32_t Index)
+{
+    uint32_t carry = Index;
+    uint8_t i = AES128_BLOCK_SIZE;
+
+    /* Counter = Initial_Counter + Index, 128-bit big-endian */
+    while (0 != i)
+    {
+        i--;
+        carry += Context->Initial_Counter[i];
+        Context->Key_Stream[i] = (uint8_t)carry;
+        carry >>= 8;
+    }
+    AES128_Encrypt_Block(&Context->Cipher, Context->Key_Stream, Context->Key_Stream);
+    Context->Key_Stream_Index = Index;
+}
+
+/*
+ *@brief Starts a CTR key stream.
+ *@details The key stream block of offset o is AES(Initial_Counter + o / 16), the counter being a 128-bit big-endian
+ *         number, so data can be processed in any order.
+ *@param Context Pointer to the context to initialize.
+ *@param Key Pointer to the AES128_KEY_SIZE byte key.
+ *@param Initial_Counter Pointer to the AES128_BLOCK_SIZE byte counter of offset 0.
+ */
+void AES128_CTR_Init(AES128_CTR_Context *Context, const uint8_t *Key, const uint8_t *Initial_Counter)
+{
+    uint8_t i = 0;
+
+    for (i = 0; i < AES128_BLOCK_SIZE; i++)
+    {
+        Context->Initial_Counter[i] = Initial_Counter[i];
+    }
+    AES128_Init(&Context->Cipher, Key);
+    AES128_CTR_Block(Context, 0);
+}
+
+/*
+ *@brief Encrypts or decrypts data in place with the key stream.
+ *@param Context Pointer to the started key stream.
+ *@param Offset Offset of the data in the stream.
+ *@param Data Pointer to the data.
+ *@param Length Number of bytes.
+ */
+void AES128_CTR_Crypt(AES128_CTR_Context *Context, uint32_t Offset, uint8_t *Data, uint32_t Length)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < Length; i++, Offset++)
+    {
+        if ((Offset / AES128_BLOCK_SIZE) != Context->Key_Stream_Index)
+        {
+            AES128_CTR_Block(Context, Offset / AES128_BLOCK_SIZE); /* One AES block per 16 bytes */
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        Data[i] ^= Context->Key_Stream[Offset % AES128_BLOCK_SIZE];
+    }
+}
+/* EOF */
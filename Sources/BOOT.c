@@ -1,9 +1,13 @@
 /**
  * @file BOOT.c
- * @brief Bootloader function to jump to the main application.
- * @details This file contains the `JumpToApplication` function which is used to transition control
- *          from the bootloader to the main application. The function sets up the stack pointer and
- *          starts execution of the application code located at a predefined address.
+ * @brief Bootloader functions to check and jump to the main application.
+ * @details This file contains the `Check_Application_Image` function which decides whether the application
+ *          slot holds a startable image, the `Check_Update_Request` function which reads the update request left by
+ *          the application, the `Boot_Sync_Window` function which reads the boot configuration, and the
+ *          `JumpToApplication` function which is used to transition control
+ *          from the bootloader to the main application. The function disables the bootloader interrupts,
+ *          relocates the vector table, sets up the stack pointer and starts execution of the application
+ *          code located at a predefined address.
  *
  * @author  Nguyen Dang Nhu Tri
  * @version 1.0
@@ -15,10 +19,11 @@
  * Includes
  ******************************************************************************/
 #include "BOOT.h"
+#include "IMAGE.h"
+#include "../Includes/DRIVER/DRIVER_NVIC.h"
 /*******************************************************************************
  * Definitions
  ******************************************************************************/
-
 /*******************************************************************************
  * Variables
  ******************************************************************************/
@@ -29,21 +34,121 @@
  * Code
  ******************************************************************************/
 
+/*
+ *@brief Checks that an application slot holds a startable image.
+ *@details The initial MSP must be word aligned and point into RAM (the top of RAM included), and the reset vector
+ *         must point inside the application region with the Thumb bit set. An erased slot (0xFFFFFFFF) fails both.
+ *         The image must then match the header programmed at the end of the last update; the full CRC32 is only
+ *         computed on the first boot after an update and every IMAGE_REVERIFY_INTERVAL boots (see IMAGE.h).
+ *@param Application_Address Address of the slot.
+ *@returns IMAGE_VALID if the image can be started, otherwise the reason why it cannot.
+ */
+BOOT_Image_Status Check_Application_Image(uint32_t Application_Address)
+{
+    BOOT_Image_Status status = IMAGE_VALID;
+    uint32_t app_msp = *(volatile uint32_t *)Application_Address;                 /* Initial stack pointer */
+    uint32_t app_reset_handler = *(volatile uint32_t *)(Application_Address + 4); /* Reset vector */
+
+    if (RAM_START_ADDRESS >= app_msp || RAM_END_ADDRESS < app_msp || 0 != (app_msp & 0x3u))
+    {
+        status = IMAGE_INVALID_STACK_POINTER;
+    }
+    else if (Application_Address > app_reset_handler || FLASH_END_ADDRESS <= app_reset_handler || 0 == (app_reset_handler & 0x1u))
+    {
+        status = IMAGE_INVALID_RESET_VECTOR;
+    }
+    else
+    {
+        status = IMAGE_Check_Installed_Image(Application_Address); /* Header and CRC32 over exactly the image length */
+    }
+
+    return status;
+}
+
+/*
+ *@brief Reads and clears the update request left by the application.
+ *@details The request only counts after a software reset, so RAM contents after power-up are never taken for one.
+ *@returns 1 if the application requested update mode; 0 otherwise.
+ */
+uint8_t Check_Update_Request(void)
+{
+    volatile uint32_t *request = (volatile uint32_t *)BOOT_UPDATE_REQUEST_ADDRESS;
+    uint8_t result = 0;
+
+    if (BOOT_UPDATE_REQUEST_MAGIC == *request && 0 != (RCM->SRS1 & RCM_SRS1_SW_MASK))
+    {
+        result = 1;
+    }
+    else
+    {
+        /* No request, or a stale one from before a power-up or pin reset */
+    }
+    *request = 0; /* The next reset boots normally */
+
+    return result;
+}
+
+/*
+ *@brief Reads the length of the UART0 sync window from the boot configuration.
+ *@returns The window in ms, BOOT_SYNC_WINDOW_DEFAULT_MS if the word is erased, at most BOOT_SYNC_WINDOW_MAX_MS.
+ */
+uint32_t Boot_Sync_Window(void)
+{
+    const volatile BOOT_Config *config = (const volatile BOOT_Config *)BOOT_CONFIG_ADDRESS;
+    uint32_t window = config->Sync_Window_Ms;
+
+    if (BOOT_CONFIG_ERASED == window)
+    {
+        window = BOOT_SYNC_WINDOW_DEFAULT_MS;
+    }
+    else if (BOOT_SYNC_WINDOW_MAX_MS < window)
+    {
+        window = BOOT_SYNC_WINDOW_MAX_MS;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    return window;
+}
+
 /*
  *@brief Jumps to the application code.
- *@details This function performs a jump to the application code located at `APPLICATION_ADDRESS`.
- *         It sets the Main Stack Pointer (MSP) to the value located at the start of the application code,
- *         then retrieves the application's reset handler address and calls it to start execution.
+ *@details This function performs a jump to the application code located at `Application_Address`.
+ *         It disables and clears all NVIC interrupts and the SysTick timer, relocates the vector table (VTOR)
+ *         to the application, sets the Main Stack Pointer (MSP) to the value located at the start of the
+ *         application code, then retrieves the application's reset handler address and calls it to start execution.
+ *         The peripherals used by the bootloader must be returned to their reset state before calling this function.
+ *@param Application_Address Address of the slot holding the application.
  */
-void JumpToApplication(void)
+void JumpToApplication(uint32_t Application_Address)
 {
+    uint32_t app_msp;                   /* Application initial stack pointer */
+    uint32_t app_reset_handler;         /* Application reset handler address */
+    void (*reset_handler)(void);        /* Application reset handler */
+
+    /* No bootloader interrupt may fire past this point */
+    __disable_irq();
+    DRIVER_NVIC_Disable_All_External_Interrupts();
+    SysTick->CTRL = 0;                                                 /* Stop SysTick and its interrupt */
+    SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk | SCB_ICSR_PENDSVCLR_Msk;       /* Clear pending SysTick and PendSV */
+
+    /* Exceptions taken by the application now use its own vector table */
+    SCB->VTOR = Application_Address;
+    __DSB();
+    __ISB();
+
     /* Set the Main Stack Pointer (MSP) to the application's stack pointer value */
-    uint32_t app_msp = *(volatile uint32_t *)APPLICATION_ADDRESS;
+    app_msp = *(volatile uint32_t *)Application_Address;
     __set_MSP(app_msp);
 
     /* Get the application's reset handler address */
-    uint32_t app_reset_handler = *(volatile uint32_t *)(APPLICATION_ADDRESS + 4);
-    void (*reset_handler)(void) = (void (*)(void))app_reset_handler;
+    app_reset_handler = *(volatile uint32_t *)(Application_Address + 4);
+    reset_handler = (void (*)(void))app_reset_handler;
+
+    /* The application starts with interrupts unmasked, as after a reset */
+    __enable_irq();
 
     /* Jump to the application's reset handler */
     reset_handler();
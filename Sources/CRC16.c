@@ -0,0 +1,61 @@
+/**
+ * @file CRC16.c
+ * @brief CRC-16 engine.
+ * @details This file contains a nibble-table CRC-16/CCITT. Transfer frames are short, so the 32-byte table is preferred
+ *          over a 512-byte one.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "CRC16.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define CRC16_STEP(crc, nibble) ((uint16_t)((crc) << 4) ^ CRC16_Table[(((crc) >> 12) ^ (nibble)) & 0x0Fu]) /* Reduce 4 bits */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*
+ *@brief CRC-16 lookup table for the polynomial 0x1021.
+ *@details Entry i is the CRC register after shifting i through 4 bit steps.
+ */
+static const uint16_t CRC16_Table[16] = {
+    0x0000u, 0x1021u, 0x2042u, 0x3063u, 0x4084u, 0x50A5u, 0x60C6u, 0x70E7u,
+    0x8108u, 0x9129u, 0xA14Au, 0xB16Bu, 0xC18Cu, 0xD1ADu, 0xE1CEu, 0xF1EFu};
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *@brief Feeds data into a CRC-16/CCITT computation.
+ *@param crc The initial register value or the value returned by the previous call.
+ *@param data Pointer to the data.
+ *@param length Number of bytes.
+ *@returns The updated CRC register value, which is the CRC of all the data fed.
+ */
+uint16_t CRC16_Update(uint16_t crc, const uint8_t *data, uint32_t length)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < length; i++)
+    {
+        crc = CRC16_STEP(crc, data[i] >> 4);
+        crc = CRC16_STEP(crc, data[i] & 0x0Fu);
+    }
+
+    return crc;
+}
+
+/* EOF */
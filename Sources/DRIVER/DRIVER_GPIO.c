@@ -6,6 +6,8 @@
  *          and utility functions for GPIO operations.
  *          These functions abstract the lower-level HAL functions to provide a more intuitive and easy-to-use interface for GPIO operations.
  *          The driver ensures that all GPIO operations are performed safely and correctly.
+ *          Pin set, clear, toggle and read operations are routed through the FGPIO (IOPORT) alias when
+ *          DRIVER_GPIO_USE_FGPIO is 1.
  *
  * @author Nguyen Dang Nhu Tri
  * @version 1.0
@@ -75,11 +77,19 @@ void DRIVER_GPIO_Output_Pin_State(GPIO_Type *GPIOx, uint8_t Pin, GPIO_PIN_STATE
 	{
 		if (HIGH == PinState)
 		{
+#if (1 == DRIVER_GPIO_USE_FGPIO)
+			HAL_FGPIO_PSOR_Port_Set_Output(DRIVER_GPIO_TO_FGPIO(GPIOx), Pin, PSOR_PTSO_LOGIC_1); /* Set the pin to high state */
+#else
 			HAL_GPIO_PSOR_Port_Set_Output(GPIOx, Pin, PSOR_PTSO_LOGIC_1); /* Set the pin to high state */
+#endif
 		}
 		else if (LOW == PinState)
 		{
+#if (1 == DRIVER_GPIO_USE_FGPIO)
+			HAL_FGPIO_PCOR_Port_Clear_Output(DRIVER_GPIO_TO_FGPIO(GPIOx), Pin, PSOR_PTCO_LOGIC_0); /* Set the pin to low state */
+#else
 			HAL_GPIO_PCOR_Port_Clear_Output(GPIOx, Pin, PSOR_PTCO_LOGIC_0); /* Set the pin to low state */
+#endif
 		}
 		else
 		{
@@ -103,7 +113,11 @@ void DRIVER_GPIO_PTOR_Toggle_Output(GPIO_Type *GPIOx, uint8_t Pin)
 {
 	if (NULL != GPIOx && 0 <= Pin && 31 >= Pin)
 	{
+#if (1 == DRIVER_GPIO_USE_FGPIO)
+		HAL_FGPIO_PTOR_Toggle_Output(DRIVER_GPIO_TO_FGPIO(GPIOx), Pin); /* Toggle the state of the specified pin */
+#else
 		HAL_GPIO_PTOR_Toggle_Output(GPIOx, Pin); /* Toggle the state of the specified pin */
+#endif
 	}
 	else
 	{
@@ -124,7 +138,11 @@ GPIO_PIN_STATE DRIVER_GPIO_PDIR_Read_Input_Pin(GPIO_Type *GPIOx, uint8_t Pin)
 
 	if (NULL != GPIOx && 0 <= Pin && 31 >= Pin)
 	{
+#if (1 == DRIVER_GPIO_USE_FGPIO)
+		pinstatus = HAL_FGPIO_PDIR_Data_Input(DRIVER_GPIO_TO_FGPIO(GPIOx), Pin); /* Read the state of the specified pin */
+#else
 		pinstatus = HAL_GPIO_PDIR_Data_Input(GPIOx, Pin); /* Read the state of the specified pin */
+#endif
 	}
 	else
 	{
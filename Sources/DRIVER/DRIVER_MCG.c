@@ -0,0 +1,120 @@
+/**
+ * @file DRIVER_MCG.c
+ * @brief  Driver functions for the MCG clock profiles.
+ * @details This file contains the functions that switch the FLL range and the SIM clock dividers between the reset
+ *          default clock profile and the high speed profile used during update sessions.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/05
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "../Includes/DRIVER/DRIVER_MCG.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define MCG_OUTDIV1_DIVIDE_BY_1 0 /* Core clock = MCGOUTCLK */
+#define MCG_OUTDIV4_DIVIDE_BY_2 1 /* Bus clock = core clock / 2 */
+#define MCG_FLL_SETTLE_LOOPS 12000u /* >= 1 ms FLL acquisition time even at 48 MHz (>= 4 cycles per loop) */
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static MCG_Clock_Profile Current_Profile = MCG_CLOCK_PROFILE_DEFAULT; /* Active clock profile */
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *@brief  Waits for the FLL to acquire the new DCO range.
+ *@returns  None
+ */
+static void DRIVER_MCG_Wait_FLL_Settle(void)
+{
+    volatile uint32_t i; /* For loop */
+
+    for (i = 0; i < MCG_FLL_SETTLE_LOOPS; i++)
+    {
+        /* Wait */
+    }
+}
+
+/*
+ *@brief  Switches the core, bus and FLL clocks to the requested profile.
+ *@details  Waits for the FLL to settle and updates SystemCoreClock. Does nothing if the profile is already active.
+ *          Peripherals clocked from MCGFLLCLK (UART0) must have their divisors recomputed by the caller.
+ *@param  Profile  Clock profile to switch to.
+ *@returns  None
+ */
+void DRIVER_MCG_Set_Clock_Profile(MCG_Clock_Profile Profile)
+{
+    if (Profile != Current_Profile && S_CLKST_FLL == HAL_MCG_S_Clock_Mode_Status())
+    {
+        /* The bus divider is the same in both profiles, it is written before raising and after lowering the clock */
+        switch (Profile)
+        {
+        case MCG_CLOCK_PROFILE_HIGH_SPEED:
+        {
+            HAL_SIM_CLKDIV1_Clock_Dividers(MCG_OUTDIV1_DIVIDE_BY_1, MCG_OUTDIV4_DIVIDE_BY_2);
+            HAL_MCG_C4_FLL_Range_Select(C4_DMX32_FINE_TUNED, C4_DRST_DRS_MID); /* 32768 Hz * 1464 */
+            break;
+        }
+        case MCG_CLOCK_PROFILE_DEFAULT:
+        {
+            HAL_MCG_C4_FLL_Range_Select(C4_DMX32_DEFAULT_RANGE, C4_DRST_DRS_LOW); /* 32768 Hz * 640 */
+            HAL_SIM_CLKDIV1_Clock_Dividers(MCG_OUTDIV1_DIVIDE_BY_1, MCG_OUTDIV4_DIVIDE_BY_2);
+            break;
+        }
+        default:
+        {
+            /* Unknown profile */
+            break;
+        }
+        }
+
+        DRIVER_MCG_Wait_FLL_Settle();
+        Current_Profile = Profile;
+        SystemCoreClockUpdate(); /* Keep SystemCoreClock in line with the new core clock */
+    }
+    else
+    {
+        /* Profile already active, or MCG not in FEI mode */
+    }
+}
+
+/*
+ *@brief  Returns the active clock profile.
+ *@returns  The active clock profile.
+ */
+MCG_Clock_Profile DRIVER_MCG_Get_Clock_Profile(void)
+{
+    return Current_Profile;
+}
+
+/*
+ *@brief  Returns the MCGFLLCLK frequency of the active clock profile.
+ *@returns  MCGFLLCLK frequency in Hz.
+ */
+uint32_t DRIVER_MCG_Get_FLL_Clock(void)
+{
+    uint32_t clock = MCG_FLL_CLOCK_DEFAULT_HZ;
+
+    if (MCG_CLOCK_PROFILE_HIGH_SPEED == Current_Profile)
+    {
+        clock = MCG_FLL_CLOCK_HIGH_SPEED_HZ;
+    }
+    else
+    {
+        /* Default profile */
+    }
+
+    return clock;
+}
+
+/* EOF */
@@ -40,6 +40,15 @@ void DRIVER_NVIC_Enable_External_Interrupt(IRQn_Type Type)
     HAL_NVIC_Enable_External_Interrupt(Type); /* Enable the external interrupt using the HAL function */
 }
 
+/*
+ *@brief Disable all external interrupts and clear their pending state using the HAL (Hardware Abstraction Layer) function.
+ *@returns No return value
+ */
+void DRIVER_NVIC_Disable_All_External_Interrupts(void)
+{
+    HAL_NVIC_Disable_All_External_Interrupts(); /* Disable and clear all external interrupts using the HAL function */
+}
+
 /*
  *@brief Assign a callback function to handle the interrupt for UART0.
  *@param  Callback: A pointer to the IRQHandler function that will be called when an interrupt occurs.
@@ -41,10 +41,11 @@ void DRIVER_PORT_Config(PORT_Config *PORT_Config)
 {
 	if (NULL != PORT_Config->PORTx && 0 <= PORT_Config->Pin && 31 >= PORT_Config->Pin)
 	{
-		HAL_PORT_PCR_Pin_Mux_Control(PORT_Config->PORTx, PORT_Config->Pin, PORT_Config->PCR.MUX);
-		HAL_PORT_PCR_Interrupt_Configuration(PORT_Config->PORTx, PORT_Config->Pin, PORT_Config->PCR.IRQC);
-		HAL_PORT_PCR_Pull_Select(PORT_Config->PORTx, PORT_Config->Pin, PORT_Config->PCR.PS);
-		HAL_PORT_PCR_Pull_Enable(PORT_Config->PORTx, PORT_Config->Pin, PORT_Config->PCR.PE);
+		/* All fields are merged into one read-modify-write of the pin control register */
+		HAL_PORT_PCR_Write_Fields(PORT_Config->PORTx, PORT_Config->Pin,
+								  PORT_PCR_MUX_MASK | PORT_PCR_IRQC_MASK | PORT_PCR_PS_MASK | PORT_PCR_PE_MASK,
+								  DRIVER_PORT_PCR_IMAGE(PORT_Config->PCR.MUX, PORT_Config->PCR.PS, PORT_Config->PCR.PE) |
+									  PORT_PCR_IRQC(PORT_Config->PCR.IRQC));
 	}
 	else
 	{
@@ -52,6 +53,69 @@ void DRIVER_PORT_Config(PORT_Config *PORT_Config)
 	}
 }
 
+/*
+ *@brief Configures several pins of a PORT with one Global Pin Control write per half-port.
+ *@details Pins 0..15 are written through GPCLR and pins 16..31 through GPCHR. IRQC lies outside the global write range,
+ *         so a non-default IRQC is applied afterwards with one PCR write per selected pin.
+ *@param PORT_Batch_Config Pointer to a PORT_Batch_Config structure that contains the pin mask and the settings.
+ *@returns None
+ */
+void DRIVER_PORT_Config_Batch(PORT_Batch_Config *PORT_Batch_Config)
+{
+	uint16_t pcr_image; /* Value written to PCR[15:0] of every selected pin */
+	uint16_t low_pins;  /* Selected pins 0..15 */
+	uint16_t high_pins; /* Selected pins 16..31 */
+	uint8_t pin;		/* For loop */
+
+	if (NULL != PORT_Batch_Config->PORTx)
+	{
+		pcr_image = (uint16_t)DRIVER_PORT_PCR_IMAGE(PORT_Batch_Config->PCR.MUX, PORT_Batch_Config->PCR.PS, PORT_Batch_Config->PCR.PE);
+		low_pins = (uint16_t)(PORT_Batch_Config->Pin_Mask & 0xFFFFu);
+		high_pins = (uint16_t)(PORT_Batch_Config->Pin_Mask >> 16);
+
+		if (0 != low_pins)
+		{
+			HAL_PORT_GPCLR_Global_Pin_Control_Low(PORT_Batch_Config->PORTx, low_pins, pcr_image);
+		}
+		else
+		{
+			/* No pin selected in the low half-port */
+		}
+
+		if (0 != high_pins)
+		{
+			HAL_PORT_GPCHR_Global_Pin_Control_High(PORT_Batch_Config->PORTx, high_pins, pcr_image);
+		}
+		else
+		{
+			/* No pin selected in the high half-port */
+		}
+
+		if (PCR_IRQC_INTERRUPT_DMA_DISABLED != PORT_Batch_Config->PCR.IRQC)
+		{
+			for (pin = 0; pin < 32; pin++)
+			{
+				if (PORT_Batch_Config->Pin_Mask & (1u << pin))
+				{
+					HAL_PORT_PCR_Interrupt_Configuration(PORT_Batch_Config->PORTx, pin, PORT_Batch_Config->PCR.IRQC);
+				}
+				else
+				{
+					/* Pin not selected */
+				}
+			}
+		}
+		else
+		{
+			/* Interrupts stay disabled */
+		}
+	}
+	else
+	{
+		/* Invalid PORTx */
+	}
+}
+
 /*
  *@brief Clears the interrupt status flag for a specified pin.
  *@param PORTx Pointer to the PORT peripheral base address.
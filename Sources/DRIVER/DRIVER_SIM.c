@@ -136,4 +136,165 @@ void DRIVER_SIM_Config(SIM_Config *SIM_Config)
     }
 }
 
+/*
+ *@brief  Computes the register masks selected by a configuration structure.
+ *@param  SIM_Config  Pointer to a SIM_Config structure that contains the settings of all registers.
+ *@param  Masks  Pointer to the structure receiving the clock gate masks and the SOPT2 fields.
+ *@returns  None
+ */
+static void DRIVER_SIM_Compute_Masks(SIM_Config *SIM_Config, SIM_Register_Masks *Masks)
+{
+    Masks->SCGC4 = SIM_SCGC4_UART0(SIM_Config->Initialize_SCGC4.UART_0) |
+                   SIM_SCGC4_UART1(SIM_Config->Initialize_SCGC4.UART_1) |
+                   SIM_SCGC4_UART2(SIM_Config->Initialize_SCGC4.UART_2);
+
+    Masks->SCGC5 = SIM_SCGC5_PORTA(SIM_Config->Initialize_SCGC5.PORT_A) |
+                   SIM_SCGC5_PORTB(SIM_Config->Initialize_SCGC5.PORT_B) |
+                   SIM_SCGC5_PORTC(SIM_Config->Initialize_SCGC5.PORT_C) |
+                   SIM_SCGC5_PORTD(SIM_Config->Initialize_SCGC5.PORT_D) |
+                   SIM_SCGC5_PORTE(SIM_Config->Initialize_SCGC5.PORT_E);
+
+    Masks->SCGC6 = SIM_SCGC6_FTF(SIM_Config->Initialize_SCGC6.FTF) |
+                   SIM_SCGC6_DMAMUX(SIM_Config->Initialize_SCGC6.DMAMUX) |
+                   SIM_SCGC6_I2S(SIM_Config->Initialize_SCGC6.I2S) |
+                   SIM_SCGC6_PIT(SIM_Config->Initialize_SCGC6.PIT_module) |
+                   SIM_SCGC6_TPM0(SIM_Config->Initialize_SCGC6.TPM_0) |
+                   SIM_SCGC6_TPM1(SIM_Config->Initialize_SCGC6.TPM_1) |
+                   SIM_SCGC6_TPM2(SIM_Config->Initialize_SCGC6.TPM_2) |
+                   SIM_SCGC6_ADC0(SIM_Config->Initialize_SCGC6.ADC_0);
+
+    Masks->SOPT2_Mask = 0;
+    Masks->SOPT2_Value = 0;
+
+    if (SOPT2_PLLFLLSEL_MCGFLLCLK != SIM_Config->Initialize_SOPT2.PLLFLLSEL)
+    {
+        Masks->SOPT2_Mask |= SIM_SOPT2_PLLFLLSEL_MASK;
+        Masks->SOPT2_Value |= SIM_SOPT2_PLLFLLSEL(SIM_Config->Initialize_SOPT2.PLLFLLSEL);
+    }
+    else
+    {
+        /* Keep the reset selection */
+    }
+
+    if (SOPT2_UART0SRC_DISABLED != SIM_Config->Initialize_SOPT2.UART0SRC)
+    {
+        Masks->SOPT2_Mask |= SIM_SOPT2_UART0SRC_MASK;
+        Masks->SOPT2_Value |= SIM_SOPT2_UART0SRC(SIM_Config->Initialize_SOPT2.UART0SRC);
+    }
+    else
+    {
+        /* Keep the reset selection */
+    }
+}
+
+/*
+ *@brief  Applies every field of the configuration structure, writing each SIM register at most once.
+ *@details  Declare_SIM_Register is ignored. Clock gates set to CLOCK_STATE_ENABLE are enabled, other gates are left
+ *          unchanged. SOPT2 fields are only updated when they hold a non-zero (non reset) selection.
+ *@param  SIM_Config  Pointer to a SIM_Config structure that contains the settings of all registers.
+ *@returns  None
+ */
+void DRIVER_SIM_Config_Batch(SIM_Config *SIM_Config)
+{
+    SIM_Register_Masks masks; /* Register masks selected by the configuration */
+
+    if (NULL != SIM_Config)
+    {
+        DRIVER_SIM_Compute_Masks(SIM_Config, &masks);
+
+        /* Clock sources first, then the clock gates, so gated modules start on the selected source */
+        if (0 != masks.SOPT2_Mask)
+        {
+            HAL_SIM_SOPT2_Write_Fields(masks.SOPT2_Mask, masks.SOPT2_Value);
+        }
+        else
+        {
+            /* Nothing to write */
+        }
+        if (0 != masks.SCGC4)
+        {
+            HAL_SIM_SCGC4_Clock_Gate_Enable_Mask(masks.SCGC4);
+        }
+        else
+        {
+            /* Nothing to write */
+        }
+        if (0 != masks.SCGC5)
+        {
+            HAL_SIM_SCGC5_Clock_Gate_Enable_Mask(masks.SCGC5);
+        }
+        else
+        {
+            /* Nothing to write */
+        }
+        if (0 != masks.SCGC6)
+        {
+            HAL_SIM_SCGC6_Clock_Gate_Enable_Mask(masks.SCGC6);
+        }
+        else
+        {
+            /* Nothing to write */
+        }
+    }
+    else
+    {
+        /* SIM_Config pointer is NULL */
+    }
+}
+
+/*
+ *@brief  Returns the registers selected by the configuration structure to their reset values.
+ *@details  Counterpart of DRIVER_SIM_Config_Batch: clock gates set to CLOCK_STATE_ENABLE are disabled and the selected
+ *          SOPT2 fields are cleared. Each SIM register is written at most once.
+ *@param  SIM_Config  Pointer to the SIM_Config structure that was used to configure the SIM.
+ *@returns  None
+ */
+void DRIVER_SIM_Reset_Batch(SIM_Config *SIM_Config)
+{
+    SIM_Register_Masks masks; /* Register masks selected by the configuration */
+
+    if (NULL != SIM_Config)
+    {
+        DRIVER_SIM_Compute_Masks(SIM_Config, &masks);
+
+        /* Clock gates first, then the clock sources, so no module runs while its source changes */
+        if (0 != masks.SCGC4)
+        {
+            HAL_SIM_SCGC4_Clock_Gate_Disable_Mask(masks.SCGC4);
+        }
+        else
+        {
+            /* Nothing to write */
+        }
+        if (0 != masks.SCGC5)
+        {
+            HAL_SIM_SCGC5_Clock_Gate_Disable_Mask(masks.SCGC5);
+        }
+        else
+        {
+            /* Nothing to write */
+        }
+        if (0 != masks.SCGC6)
+        {
+            HAL_SIM_SCGC6_Clock_Gate_Disable_Mask(masks.SCGC6);
+        }
+        else
+        {
+            /* Nothing to write */
+        }
+        if (0 != masks.SOPT2_Mask)
+        {
+            HAL_SIM_SOPT2_Write_Fields(masks.SOPT2_Mask, 0);
+        }
+        else
+        {
+            /* Nothing to write */
+        }
+    }
+    else
+    {
+        /* SIM_Config pointer is NULL */
+    }
+}
+
 /* EOF */
@@ -35,14 +35,16 @@
  */
 void DRIVER_UART_Config(UART_Config *UART_Config)
 {
+    UART_Image image;
+
     if (NULL != UART_Config->UARTx)
     {
-        HAL_UART_BDL_Baud_Rate_Modulo_Divisor(UART_Config->UARTx, UART_Config->BDL);
-        HAL_UART_BDH_Baud_Rate_Modulo_Divisor(UART_Config->UARTx, UART_Config->BDH.SBR);
-        HAL_UART_BDH_Stop_Bit_Number_Select(UART_Config->UARTx, UART_Config->BDH.SBNS);
-        HAL_UART_C2_Transmitter_Enable(UART_Config->UARTx, UART_Config->C2.TE);
-        HAL_UART_C2_Receiver_Interrupt_Enable_for_RDRF(UART_Config->UARTx, UART_Config->C2.RIE);
-        HAL_UART_C2_Receiverr_Enable(UART_Config->UARTx, UART_Config->C2.RE);
+        /* Compute the final register images, then write each register once */
+        image.BDH = UART_BDH_SBR(UART_Config->BDH.SBR) | UART_BDH_SBNS(UART_Config->BDH.SBNS);
+        image.BDL = UART_BDL_SBR(UART_Config->BDL);
+        image.C2 = UART_C2_TE(UART_Config->C2.TE) | UART_C2_RE(UART_Config->C2.RE) | UART_C2_RIE(UART_Config->C2.RIE);
+
+        DRIVER_UART_Config_Image(UART_Config->UARTx, &image);
     }
     else
     {
@@ -50,6 +52,58 @@ void DRIVER_UART_Config(UART_Config *UART_Config)
     }
 }
 
+/*
+ *@brief  Apply precomputed register images to the UART peripheral
+ *@details  Writes BDH, BDL and C2 exactly once each, BDH first because the baud rate divisor is latched on the BDL write.
+ *@param  UARTx: Pointer to the UART peripheral
+ *@param  UART_Image: Pointer to the register images to apply
+ *@returns  None
+ */
+void DRIVER_UART_Config_Image(UART_Type *UARTx, const UART_Image *UART_Image)
+{
+    if (NULL != UARTx && NULL != UART_Image)
+    {
+        HAL_UART_BDH_Write_Register(UARTx, UART_Image->BDH);
+        HAL_UART_BDL_Write_Register(UARTx, UART_Image->BDL);
+        HAL_UART_C2_Write_Register(UARTx, UART_Image->C2);
+    }
+    else
+    {
+        /* UARTx or UART_Image pointer is NULL */
+    }
+}
+
+/*
+ *@brief  Recompute and apply the baud rate divisor for a new module clock
+ *@details  The transmitter and receiver are disabled while BDH/BDL are written and C2 is restored afterwards.
+ *          Callers should make sure the last transmission has completed.
+ *@param  UARTx: Pointer to the UART peripheral
+ *@param  Clock_Hz: UART module clock in Hz
+ *@param  Baud_Rate: Requested baud rate
+ *@param  Oversampling: Receiver oversampling ratio (16 for UART1/UART2, OSR + 1 for UART0)
+ *@returns  None
+ */
+void DRIVER_UART_Set_Baud_Rate(UART_Type *UARTx, uint32_t Clock_Hz, uint32_t Baud_Rate, uint8_t Oversampling)
+{
+    uint16_t sbr;  /* Baud rate modulo divisor */
+    uint8_t c2;    /* Saved Control Register 2 */
+
+    if (NULL != UARTx && 0 != Baud_Rate && 0 != Oversampling)
+    {
+        sbr = (uint16_t)DRIVER_UART_SBR(Clock_Hz, Baud_Rate, (uint32_t)Oversampling);
+        c2 = HAL_UART_C2_Read_Register(UARTx);
+
+        HAL_UART_C2_Write_Register(UARTx, c2 & ~(UART_C2_TE_MASK | UART_C2_RE_MASK)); /* Divisor must only change while TE = RE = 0 */
+        HAL_UART_BDH_Baud_Rate_Modulo_Divisor(UARTx, (uint8_t)(sbr >> 8));
+        HAL_UART_BDL_Baud_Rate_Modulo_Divisor(UARTx, (uint8_t)(sbr & 0xFFu));
+        HAL_UART_C2_Write_Register(UARTx, c2);
+    }
+    else
+    {
+        /* Invalid parameters */
+    }
+}
+
 /*
  *@brief  Check if the UART receive data register is full
  *@param  UARTx: Pointer to the UART peripheral
@@ -92,6 +146,23 @@ S1_TC_enum DRIVER_UART_S1_Transmission_Complete_Flag(UART_Type *UARTx)
     return flagStatus;
 }
 
+/*
+ *@brief  Clear the UART receiver overrun flag
+ *@param  UARTx: Pointer to the UART peripheral
+ *@returns  None
+ */
+void DRIVER_UART_S1_Clear_Overrun_Flag(UART_Type *UARTx)
+{
+    if (NULL != UARTx)
+    {
+        HAL_UART_S1_Clear_Overrun_Flag(UARTx);
+    }
+    else
+    {
+        /* UARTx pointer is NULL */
+    }
+}
+
 /*
  *@brief  Write data to the UART transmit data buffer
  *@param  UARTx: Pointer to the UART peripheral
@@ -0,0 +1,571 @@
+/**
+ * @file ECDSA.c
+ * @brief ECDSA P-256 signature verification.
+ * @details This file contains a small ECDSA verifier over the NIST P-256 curve. The scalars u1 = e / s and
+ *          u2 = r / s are computed with a binary modular inverse and Montgomery multiplications modulo n, then
+ *          u1 * G + u2 * Q is accumulated bit by bit in Jacobian coordinates (a = -3 doubling, mixed addition).
+ *          The final comparison is done in Jacobian coordinates (r * Z^2 == X), so no inversion modulo p is needed.
+ *          The code favours size over speed and is not constant time, which is fine for verifying public data.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "ECDSA.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define ECDSA_P_M0INV 0x00000001u /* -p^-1 mod 2^32 */
+#define ECDSA_N_M0INV 0xEE00BC4Fu /* -n^-1 mod 2^32 */
+
+#define ECDSA_FIELD_MUL(r, a, b) ECDSA_Mont_Mul((r), (a), (b), ECDSA_P, ECDSA_P_M0INV)
+#define ECDSA_FIELD_ADD(r, a, b) ECDSA_Mod_Add((r), (a), (b), ECDSA_P)
+#define ECDSA_FIELD_SUB(r, a, b) ECDSA_Mod_Sub((r), (a), (b), ECDSA_P)
+
+#ifndef ECDSA_PROBE
+#define ECDSA_PROBE(Operation) /* Defined by tools/ecdsa_bench.c to count the operations, empty on the target */
+#endif
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* Curve constants, least significant limb first */
+static const uint32_t ECDSA_ZERO[ECDSA_P256_WORDS] = {0};
+static const uint32_t ECDSA_P[ECDSA_P256_WORDS] = {
+    0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00000000u, 0x00000000u, 0x00000000u, 0x00000001u, 0xFFFFFFFFu};
+static const uint32_t ECDSA_N[ECDSA_P256_WORDS] = {
+    0xFC632551u, 0xF3B9CAC2u, 0xA7179E84u, 0xBCE6FAADu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0x00000000u, 0xFFFFFFFFu};
+static const uint32_t ECDSA_P_R2[ECDSA_P256_WORDS] = { /* 2^512 mod p */
+    0x00000003u, 0x00000000u, 0xFFFFFFFFu, 0xFFFFFFFBu, 0xFFFFFFFEu, 0xFFFFFFFFu, 0xFFFFFFFDu, 0x00000004u};
+static const uint32_t ECDSA_N_R2[ECDSA_P256_WORDS] = { /* 2^512 mod n */
+    0xBE79EEA2u, 0x83244C95u, 0x49BD6FA6u, 0x4699799Cu, 0x2B6BEC59u, 0x2845B239u, 0xF3D95620u, 0x66E12D94u};
+static const uint32_t ECDSA_P_ONE[ECDSA_P256_WORDS] = { /* 2^256 mod p, 1 in the Montgomery domain */
+    0x00000001u, 0x00000000u, 0x00000000u, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFFu, 0xFFFFFFFEu, 0x00000000u};
+static const uint32_t ECDSA_GX[ECDSA_P256_WORDS] = {
+    0xD898C296u, 0xF4A13945u, 0x2DEB33A0u, 0x77037D81u, 0x63A440F2u, 0xF8BCE6E5u, 0xE12C4247u, 0x6B17D1F2u};
+static const uint32_t ECDSA_GY[ECDSA_P256_WORDS] = {
+    0x37BF51F5u, 0xCBB64068u, 0x6B315ECEu, 0x2BCE3357u, 0x7C0F9E16u, 0x8EE7EB4Au, 0xFE1A7F9Bu, 0x4FE342E2u};
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+static uint32_t ECDSA_Add(uint32_t *r, const uint32_t *a, const uint32_t *b);
+static uint32_t ECDSA_Sub(uint32_t *r, const uint32_t *a, const uint32_t *b);
+static int8_t ECDSA_Compare(const uint32_t *a, const uint32_t *b);
+static uint8_t ECDSA_Is_Zero(const uint32_t *a);
+static uint8_t ECDSA_Is_One(const uint32_t *a);
+static void ECDSA_Copy(uint32_t *r, const uint32_t *a);
+static void ECDSA_Half_Mod(uint32_t *a, const uint32_t *m);
+static void ECDSA_Mod_Add(uint32_t *r, const uint32_t *a, const uint32_t *b, const uint32_t *m);
+static void ECDSA_Mod_Sub(uint32_t *r, const uint32_t *a, const uint32_t *b, const uint32_t *m);
+static void ECDSA_Mont_Mul(uint32_t *r, const uint32_t *a, const uint32_t *b, const uint32_t *m, uint32_t m0inv);
+static void ECDSA_Mod_Inverse(uint32_t *r, const uint32_t *a, const uint32_t *m);
+static void ECDSA_From_Bytes(uint32_t *r, const uint8_t *bytes);
+static void ECDSA_Point_Double(ECDSA_P256_Context *Context);
+static void ECDSA_Point_Add(ECDSA_P256_Context *Context, const uint32_t *x2, const uint32_t *y2);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *@brief r = a + b.
+ *@returns The carry out.
+ */
+static uint32_t ECDSA_Add(uint32_t *r, const uint32_t *a, const uint32_t *b)
+{
+    uint64_t acc = 0;
+    uint8_t i = 0;
+
+    ECDSA_PROBE(ADD);
+    for (i = 0; i < ECDSA_P256_WORDS; i++)
+    {
+        acc += (uint64_t)a[i] + b[i];
+        r[i] = (uint32_t)acc;
+        acc >>= 32;
+    }
+
+    return (uint32_t)acc;
+}
+
+/*
+ *@brief r = a - b.
+ *@returns The borrow out.
+ */
+static uint32_t ECDSA_Sub(uint32_t *r, const uint32_t *a, const uint32_t *b)
+{
+    uint64_t acc = 0;
+    uint32_t borrow = 0;
+    uint8_t i = 0;
+
+    ECDSA_PROBE(SUB);
+    for (i = 0; i < ECDSA_P256_WORDS; i++)
+    {
+        acc = (uint64_t)a[i] - b[i] - borrow;
+        r[i] = (uint32_t)acc;
+        borrow = (uint32_t)(acc >> 32) & 1u;
+    }
+
+    return borrow;
+}
+
+/*
+ *@brief Compares a and b.
+ *@returns -1, 0 or 1 if a is less than, equal to or greater than b.
+ */
+static int8_t ECDSA_Compare(const uint32_t *a, const uint32_t *b)
+{
+    int8_t result = 0;
+    int8_t i = 0;
+
+    ECDSA_PROBE(COMPARE);
+    for (i = ECDSA_P256_WORDS - 1; i >= 0 && 0 == result; i--)
+    {
+        if (a[i] > b[i])
+        {
+            result = 1;
+        }
+        else if (a[i] < b[i])
+        {
+            result = -1;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+
+    return result;
+}
+
+/*
+ *@brief Returns 1 if a is 0.
+ */
+static uint8_t ECDSA_Is_Zero(const uint32_t *a)
+{
+    uint32_t bits = 0;
+    uint8_t i = 0;
+
+    ECDSA_PROBE(IS_ZERO);
+    for (i = 0; i < ECDSA_P256_WORDS; i++)
+    {
+        bits |= a[i];
+    }
+
+    return (0 == bits) ? 1 : 0;
+}
+
+/*
+ *@brief Returns 1 if a is 1.
+ */
+static uint8_t ECDSA_Is_One(const uint32_t *a)
+{
+    uint32_t bits = a[0] ^ 1u;
+    uint8_t i = 0;
+
+    ECDSA_PROBE(IS_ONE);
+    for (i = 1; i < ECDSA_P256_WORDS; i++)
+    {
+        bits |= a[i];
+    }
+
+    return (0 == bits) ? 1 : 0;
+}
+
+/*
+ *@brief r = a.
+ */
+static void ECDSA_Copy(uint32_t *r, const uint32_t *a)
+{
+    uint8_t i = 0;
+
+    ECDSA_PROBE(COPY);
+    for (i = 0; i < ECDSA_P256_WORDS; i++)
+    {
+        r[i] = a[i];
+    }
+}
+
+/*
+ *@brief a = a / 2 mod m, m odd.
+ */
+static void ECDSA_Half_Mod(uint32_t *a, const uint32_t *m)
+{
+    uint32_t top = 0;
+    uint8_t i = 0;
+
+    ECDSA_PROBE(HALF);
+    if (0 != (a[0] & 1u))
+    {
+        top = ECDSA_Add(a, a, m); /* Make it even, the carry becomes bit 255 after the shift */
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    for (i = 0; i < ECDSA_P256_WORDS - 1u; i++)
+    {
+        a[i] = (a[i] >> 1) | (a[i + 1u] << 31);
+    }
+    a[ECDSA_P256_WORDS - 1u] = (a[ECDSA_P256_WORDS - 1u] >> 1) | (top << 31);
+}
+
+/*
+ *@brief r = a + b mod m, with a and b below m.
+ */
+static void ECDSA_Mod_Add(uint32_t *r, const uint32_t *a, const uint32_t *b, const uint32_t *m)
+{
+    if (0 != ECDSA_Add(r, a, b) || 0 <= ECDSA_Compare(r, m))
+    {
+        (void)ECDSA_Sub(r, r, m);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/*
+ *@brief r = a - b mod m, with a and b below m.
+ */
+static void ECDSA_Mod_Sub(uint32_t *r, const uint32_t *a, const uint32_t *b, const uint32_t *m)
+{
+    if (0 != ECDSA_Sub(r, a, b))
+    {
+        (void)ECDSA_Add(r, r, m);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/*
+ *@brief Montgomery multiplication r = a * b / 2^256 mod m (CIOS), with a and b below m.
+ *@details r may alias a or b.
+ */
+static void ECDSA_Mont_Mul(uint32_t *r, const uint32_t *a, const uint32_t *b, const uint32_t *m, uint32_t m0inv)
+{
+    uint32_t t[ECDSA_P256_WORDS + 2u] = {0};
+    uint64_t acc = 0;
+    uint32_t q = 0;
+    uint8_t i = 0;
+    uint8_t j = 0;
+
+    ECDSA_PROBE(MONT_MUL);
+    for (i = 0; i < ECDSA_P256_WORDS; i++)
+    {
+        /* t += a * b[i] */
+        acc = 0;
+        for (j = 0; j < ECDSA_P256_WORDS; j++)
+        {
+            acc = (uint64_t)t[j] + (uint64_t)a[j] * b[i] + (acc >> 32);
+            t[j] = (uint32_t)acc;
+        }
+        acc = (uint64_t)t[ECDSA_P256_WORDS] + (acc >> 32);
+        t[ECDSA_P256_WORDS] = (uint32_t)acc;
+        t[ECDSA_P256_WORDS + 1u] = (uint32_t)(acc >> 32);
+
+        /* t = (t + q * m) / 2^32 */
+        q = t[0] * m0inv;
+        acc = (uint64_t)t[0] + (uint64_t)q * m[0];
+        for (j = 1; j < ECDSA_P256_WORDS; j++)
+        {
+            acc = (uint64_t)t[j] + (uint64_t)q * m[j] + (acc >> 32);
+            t[j - 1u] = (uint32_t)acc;
+        }
+        acc = (uint64_t)t[ECDSA_P256_WORDS] + (acc >> 32);
+        t[ECDSA_P256_WORDS - 1u] = (uint32_t)acc;
+        t[ECDSA_P256_WORDS] = t[ECDSA_P256_WORDS + 1u] + (uint32_t)(acc >> 32);
+    }
+
+    if (0 != t[ECDSA_P256_WORDS] || 0 <= ECDSA_Compare(t, m))
+    {
+        (void)ECDSA_Sub(t, t, m);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    ECDSA_Copy(r, t);
+}
+
+/*
+ *@brief r = a^-1 mod m, m odd prime, a in [1, m - 1] (binary extended Euclid).
+ */
+static void ECDSA_Mod_Inverse(uint32_t *r, const uint32_t *a, const uint32_t *m)
+{
+    uint32_t u[ECDSA_P256_WORDS];
+    uint32_t v[ECDSA_P256_WORDS];
+    uint32_t x1[ECDSA_P256_WORDS] = {1u};
+    uint32_t x2[ECDSA_P256_WORDS] = {0};
+
+    ECDSA_Copy(u, a);
+    ECDSA_Copy(v, m);
+    while (0 == ECDSA_Is_One(u) && 0 == ECDSA_Is_One(v))
+    {
+        while (0 == (u[0] & 1u))
+        {
+            ECDSA_Half_Mod(u, ECDSA_ZERO); /* u is even: plain shift */
+            ECDSA_Half_Mod(x1, m);
+        }
+        while (0 == (v[0] & 1u))
+        {
+            ECDSA_Half_Mod(v, ECDSA_ZERO);
+            ECDSA_Half_Mod(x2, m);
+        }
+        if (0 <= ECDSA_Compare(u, v))
+        {
+            (void)ECDSA_Sub(u, u, v);
+            ECDSA_Mod_Sub(x1, x1, x2, m);
+        }
+        else
+        {
+            (void)ECDSA_Sub(v, v, u);
+            ECDSA_Mod_Sub(x2, x2, x1, m);
+        }
+    }
+
+    ECDSA_Copy(r, (0 != ECDSA_Is_One(u)) ? x1 : x2);
+}
+
+/*
+ *@brief Loads a 32-byte big-endian number.
+ */
+static void ECDSA_From_Bytes(uint32_t *r, const uint8_t *bytes)
+{
+    uint8_t i = 0;
+
+    for (i = 0; i < ECDSA_P256_WORDS; i++)
+    {
+        r[ECDSA_P256_WORDS - 1u - i] = ((uint32_t)bytes[4u * i] << 24) | ((uint32_t)bytes[4u * i + 1u] << 16) |
+                                       ((uint32_t)bytes[4u * i + 2u] << 8) | (uint32_t)bytes[4u * i + 3u];
+    }
+}
+
+/*
+ *@brief Doubles the accumulator (Jacobian, a = -3). The point at infinity (Z = 0) stays at infinity.
+ */
+static void ECDSA_Point_Double(ECDSA_P256_Context *Context)
+{
+    uint32_t delta[ECDSA_P256_WORDS];
+    uint32_t gamma[ECDSA_P256_WORDS];
+    uint32_t beta[ECDSA_P256_WORDS];
+    uint32_t alpha[ECDSA_P256_WORDS];
+    uint32_t t1[ECDSA_P256_WORDS];
+    uint32_t t2[ECDSA_P256_WORDS];
+
+    ECDSA_FIELD_MUL(delta, Context->Z, Context->Z); /* delta = Z^2 */
+    ECDSA_FIELD_MUL(gamma, Context->Y, Context->Y); /* gamma = Y^2 */
+    ECDSA_FIELD_MUL(beta, Context->X, gamma);       /* beta = X * gamma */
+
+    ECDSA_FIELD_SUB(t1, Context->X, delta); /* alpha = 3 * (X - delta) * (X + delta) */
+    ECDSA_FIELD_ADD(t2, Context->X, delta);
+    ECDSA_FIELD_MUL(alpha, t1, t2);
+    ECDSA_FIELD_ADD(t1, alpha, alpha);
+    ECDSA_FIELD_ADD(alpha, t1, alpha);
+
+    ECDSA_FIELD_ADD(t1, Context->Y, Context->Z); /* Z3 = (Y + Z)^2 - gamma - delta */
+    ECDSA_FIELD_MUL(t1, t1, t1);
+    ECDSA_FIELD_SUB(t1, t1, gamma);
+    ECDSA_FIELD_SUB(Context->Z, t1, delta);
+
+    ECDSA_FIELD_ADD(beta, beta, beta); /* beta = 4 * beta, t2 = 8 * beta */
+    ECDSA_FIELD_ADD(beta, beta, beta);
+    ECDSA_FIELD_ADD(t2, beta, beta);
+    ECDSA_FIELD_MUL(t1, alpha, alpha); /* X3 = alpha^2 - 8 * beta */
+    ECDSA_FIELD_SUB(Context->X, t1, t2);
+
+    ECDSA_FIELD_SUB(t1, beta, Context->X); /* Y3 = alpha * (4 * beta - X3) - 8 * gamma^2 */
+    ECDSA_FIELD_MUL(t1, alpha, t1);
+    ECDSA_FIELD_MUL(gamma, gamma, gamma);
+    ECDSA_FIELD_ADD(gamma, gamma, gamma);
+    ECDSA_FIELD_ADD(gamma, gamma, gamma);
+    ECDSA_FIELD_ADD(gamma, gamma, gamma);
+    ECDSA_FIELD_SUB(Context->Y, t1, gamma);
+}
+
+/*
+ *@brief Adds the affine point (x2, y2) to the accumulator (Jacobian mixed addition).
+ */
+static void ECDSA_Point_Add(ECDSA_P256_Context *Context, const uint32_t *x2, const uint32_t *y2)
+{
+    uint32_t z1z1[ECDSA_P256_WORDS];
+    uint32_t h[ECDSA_P256_WORDS];
+    uint32_t r[ECDSA_P256_WORDS];
+    uint32_t hhh[ECDSA_P256_WORDS];
+    uint32_t v[ECDSA_P256_WORDS];
+    uint32_t t[ECDSA_P256_WORDS];
+
+    if (0 != ECDSA_Is_Zero(Context->Z))
+    {
+        /* Infinity + P = P */
+        ECDSA_Copy(Context->X, x2);
+        ECDSA_Copy(Context->Y, y2);
+        ECDSA_Copy(Context->Z, ECDSA_P_ONE);
+    }
+    else
+    {
+        ECDSA_FIELD_MUL(z1z1, Context->Z, Context->Z); /* H = x2 * Z^2 - X */
+        ECDSA_FIELD_MUL(h, x2, z1z1);
+        ECDSA_FIELD_SUB(h, h, Context->X);
+        ECDSA_FIELD_MUL(r, y2, Context->Z); /* r = y2 * Z^3 - Y */
+        ECDSA_FIELD_MUL(r, r, z1z1);
+        ECDSA_FIELD_SUB(r, r, Context->Y);
+
+        if (0 != ECDSA_Is_Zero(h) && 0 != ECDSA_Is_Zero(r))
+        {
+            ECDSA_Point_Double(Context); /* Same point */
+        }
+        else if (0 != ECDSA_Is_Zero(h))
+        {
+            ECDSA_Copy(Context->Z, h); /* Opposite points: infinity */
+        }
+        else
+        {
+            ECDSA_FIELD_MUL(t, h, h);                   /* HH */
+            ECDSA_FIELD_MUL(hhh, h, t);                 /* HHH = H * HH */
+            ECDSA_FIELD_MUL(v, Context->X, t);          /* V = X * HH */
+            ECDSA_FIELD_MUL(t, Context->Y, hhh);        /* Y * HHH, before Y is overwritten */
+            ECDSA_FIELD_MUL(Context->Z, Context->Z, h); /* Z3 = Z * H */
+
+            ECDSA_FIELD_MUL(Context->X, r, r); /* X3 = r^2 - HHH - 2 * V */
+            ECDSA_FIELD_SUB(Context->X, Context->X, hhh);
+            ECDSA_FIELD_SUB(Context->X, Context->X, v);
+            ECDSA_FIELD_SUB(Context->X, Context->X, v);
+
+            ECDSA_FIELD_SUB(v, v, Context->X); /* Y3 = r * (V - X3) - Y * HHH */
+            ECDSA_FIELD_MUL(v, r, v);
+            ECDSA_FIELD_SUB(Context->Y, v, t);
+        }
+    }
+}
+
+/*
+ *@brief Starts the verification of a signature over a SHA-256 digest.
+ *@details Checks the ranges of r and s, computes the two scalars and prepares the ladder. Takes about as long as
+ *         the heaviest ladder step, 6 ms on the target at 47.97 MHz (tools/ecdsa_bench).
+ *@param Context Pointer to the context to initialize.
+ *@param Public_Key Pointer to the public key, X || Y big-endian.
+ *@param Digest Pointer to the SHA-256 digest of the signed data.
+ *@param Signature Pointer to the signature, r || s big-endian.
+ */
+void ECDSA_P256_Verify_Start(ECDSA_P256_Context *Context, const uint8_t *Public_Key, const uint8_t *Digest,
+                             const uint8_t *Signature)
+{
+    uint32_t s[ECDSA_P256_WORDS];
+    uint32_t e[ECDSA_P256_WORDS];
+    uint32_t w[ECDSA_P256_WORDS];
+
+    ECDSA_From_Bytes(Context->R, Signature);
+    ECDSA_From_Bytes(s, Signature + ECDSA_P256_WORDS * 4u);
+    ECDSA_From_Bytes(e, Digest);
+    ECDSA_From_Bytes(Context->QX, Public_Key);
+    ECDSA_From_Bytes(Context->QY, Public_Key + ECDSA_P256_WORDS * 4u);
+
+    if (0 != ECDSA_Is_Zero(Context->R) || 0 <= ECDSA_Compare(Context->R, ECDSA_N) || 0 != ECDSA_Is_Zero(s) ||
+        0 <= ECDSA_Compare(s, ECDSA_N) || 0 <= ECDSA_Compare(Context->QX, ECDSA_P) ||
+        0 <= ECDSA_Compare(Context->QY, ECDSA_P))
+    {
+        Context->Status = ECDSA_INVALID;
+    }
+    else
+    {
+        if (0 <= ECDSA_Compare(e, ECDSA_N))
+        {
+            (void)ECDSA_Sub(e, e, ECDSA_N); /* e < 2^256 < 2n */
+        }
+        else
+        {
+            /* Do nothing */
+        }
+
+        ECDSA_Mod_Inverse(w, s, ECDSA_N);                                    /* w = 1 / s */
+        ECDSA_Mont_Mul(Context->U1, e, w, ECDSA_N, ECDSA_N_M0INV);           /* u1 = e * w */
+        ECDSA_Mont_Mul(Context->U1, Context->U1, ECDSA_N_R2, ECDSA_N, ECDSA_N_M0INV);
+        ECDSA_Mont_Mul(Context->U2, Context->R, w, ECDSA_N, ECDSA_N_M0INV);  /* u2 = r * w */
+        ECDSA_Mont_Mul(Context->U2, Context->U2, ECDSA_N_R2, ECDSA_N, ECDSA_N_M0INV);
+
+        ECDSA_FIELD_MUL(Context->GX, ECDSA_GX, ECDSA_P_R2); /* Points to the Montgomery domain */
+        ECDSA_FIELD_MUL(Context->GY, ECDSA_GY, ECDSA_P_R2);
+        ECDSA_FIELD_MUL(Context->QX, Context->QX, ECDSA_P_R2);
+        ECDSA_FIELD_MUL(Context->QY, Context->QY, ECDSA_P_R2);
+
+        ECDSA_Copy(Context->X, ECDSA_P_ONE); /* Accumulator at infinity */
+        ECDSA_Copy(Context->Y, ECDSA_P_ONE);
+        ECDSA_Copy(Context->Z, ECDSA_ZERO);
+        Context->Bit = (int16_t)(ECDSA_P256_WORDS * 32u - 1u);
+        Context->Status = ECDSA_BUSY;
+    }
+}
+
+/*
+ *@brief Runs one step of a started verification.
+ *@details Each step processes one of the 256 scalar bits (one point doubling and up to two point additions);
+ *         the last step compares the result with r.
+ *@param Context Pointer to the context.
+ *@returns ECDSA_BUSY while steps remain, then ECDSA_VALID or ECDSA_INVALID.
+ */
+ECDSA_Status ECDSA_P256_Verify_Step(ECDSA_P256_Context *Context)
+{
+    uint32_t z2[ECDSA_P256_WORDS];
+    uint32_t t[ECDSA_P256_WORDS];
+
+    if (ECDSA_BUSY != Context->Status)
+    {
+        /* Nothing to do */
+    }
+    else if (0 <= Context->Bit)
+    {
+        ECDSA_Point_Double(Context);
+        if (0 != ((Context->U1[Context->Bit >> 5] >> (Context->Bit & 31)) & 1u))
+        {
+            ECDSA_Point_Add(Context, Context->GX, Context->GY);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        if (0 != ((Context->U2[Context->Bit >> 5] >> (Context->Bit & 31)) & 1u))
+        {
+            ECDSA_Point_Add(Context, Context->QX, Context->QY);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        Context->Bit--;
+    }
+    else if (0 != ECDSA_Is_Zero(Context->Z))
+    {
+        Context->Status = ECDSA_INVALID;
+    }
+    else
+    {
+        /* x(u1 * G + u2 * Q) mod n == r, checked as r * Z^2 == X for r and, if below p, r + n */
+        ECDSA_FIELD_MUL(z2, Context->Z, Context->Z);
+        ECDSA_FIELD_MUL(t, Context->R, ECDSA_P_R2);
+        ECDSA_FIELD_MUL(t, t, z2);
+        Context->Status = (0 == ECDSA_Compare(t, Context->X)) ? ECDSA_VALID : ECDSA_INVALID;
+
+        if (ECDSA_INVALID == Context->Status && 0 == ECDSA_Add(t, Context->R, ECDSA_N) && 0 > ECDSA_Compare(t, ECDSA_P))
+        {
+            ECDSA_FIELD_MUL(t, t, ECDSA_P_R2);
+            ECDSA_FIELD_MUL(t, t, z2);
+            Context->Status = (0 == ECDSA_Compare(t, Context->X)) ? ECDSA_VALID : ECDSA_INVALID;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+
+    return Context->Status;
+}
+/* EOF */
@@ -0,0 +1,200 @@
+/**
+ * @file FRAME.c
+ * @brief Binary transfer frame parser.
+ * @details This file contains the parser of the binary frames described in FRAME.h. The UART0 interrupt stores a
+ *          frame in a queue element using FRAME_Size; the main loop then checks and decodes it with FRAME_Parse. No
+ *          hex conversion is needed, the payload is copied as is.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "FRAME.h"
+#include "CRC16.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *@brief Returns the total size of a frame from its header.
+ *@param frame Pointer to the frame, at least FRAME_LENGTH_INDEX + 1 bytes received.
+ *@returns Number of bytes of the whole frame; 0 if the length is invalid.
+ */
+uint8_t FRAME_Size(volatile char *frame)
+{
+    uint8_t length = (uint8_t)frame[FRAME_LENGTH_INDEX];
+    uint8_t size = 0;
+
+    if (FRAME_MAX_PAYLOAD >= length)
+    {
+        size = FRAME_HEADER_SIZE + length + FRAME_CRC_SIZE;
+    }
+    else
+    {
+        /* Corrupted length */
+    }
+
+    return size;
+}
+
+/*
+ *@brief Adds a received byte to the frame being collected.
+ *@details Bytes outside a frame are dropped until a sync byte. A frame with an invalid length byte is dropped, and
+ *         collection resynchronizes on the next sync byte.
+ *@param frame Pointer to the queue element collecting the frame.
+ *@param Index Pointer to the number of bytes collected, 0 between frames.
+ *@param Data The received byte.
+ *@returns 1 once the frame is complete, *Index being back to 0; 0 otherwise.
+ */
+uint8_t FRAME_Collect(volatile char *frame, volatile uint8_t *Index, uint8_t Data)
+{
+    uint8_t complete = 0;
+
+    if (0 != *Index || FRAME_SYNC == Data)
+    {
+        frame[(*Index)++] = (char)Data;
+        if (FRAME_LENGTH_INDEX >= *Index)
+        {
+            /* Length not received yet */
+        }
+        else if (0 == FRAME_Size(frame))
+        {
+            *Index = 0; /* Corrupted length */
+        }
+        else if (FRAME_Size(frame) == *Index)
+        {
+            *Index = 0;
+            complete = 1;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    return complete;
+}
+
+/*
+ *@brief Checks the sync byte, length and CRC of a complete frame.
+ *@param frame Pointer to the complete frame.
+ *@returns 1 if the frame is intact; 0 otherwise.
+ */
+uint8_t FRAME_Check(volatile char *frame)
+{
+    const uint8_t *bytes = (const uint8_t *)frame; /* The interrupt no longer writes a completed frame */
+    uint8_t length = bytes[FRAME_LENGTH_INDEX];
+    uint8_t result = 0;
+    uint16_t crc_in_frame = 0;
+
+    if (FRAME_SYNC == bytes[0] && FRAME_MAX_PAYLOAD >= length)
+    {
+        crc_in_frame = ((uint16_t)bytes[FRAME_HEADER_SIZE + length] << 8) | bytes[FRAME_HEADER_SIZE + length + 1];
+        if (crc_in_frame == CRC16_Update(CRC16_INITIAL_VALUE, &bytes[FRAME_TYPE_INDEX], FRAME_HEADER_SIZE - 1 + length))
+        {
+            result = 1;
+        }
+        else
+        {
+            /* Do Nothing */
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return result;
+}
+
+/*
+ *@brief Builds a frame.
+ *@param frame Pointer to the destination, at least FRAME_HEADER_SIZE + Length + FRAME_CRC_SIZE bytes long.
+ *@param Type The S-record type digit the frame stands for ('0', '1' or '9').
+ *@param Sequence The sequence number.
+ *@param Address The address field.
+ *@param Data Pointer to the payload.
+ *@param Length Number of payload bytes, at most FRAME_MAX_PAYLOAD.
+ *@returns None
+ */
+void FRAME_Build(volatile char *frame, char Type, uint8_t Sequence, uint32_t Address, const uint8_t *Data, uint8_t Length)
+{
+    uint8_t *bytes = (uint8_t *)frame; /* Built before the element is handed to the update loop */
+    uint16_t crc = 0;
+    uint8_t i = 0;
+
+    bytes[0] = FRAME_SYNC;
+    bytes[FRAME_TYPE_INDEX] = (uint8_t)Type;
+    bytes[FRAME_SEQUENCE_INDEX] = Sequence;
+    bytes[FRAME_LENGTH_INDEX] = Length;
+    bytes[FRAME_ADDRESS_INDEX] = (uint8_t)(Address >> 24);
+    bytes[FRAME_ADDRESS_INDEX + 1] = (uint8_t)(Address >> 16);
+    bytes[FRAME_ADDRESS_INDEX + 2] = (uint8_t)(Address >> 8);
+    bytes[FRAME_ADDRESS_INDEX + 3] = (uint8_t)Address;
+    for (i = 0; i < Length; i++)
+    {
+        bytes[FRAME_HEADER_SIZE + i] = Data[i];
+    }
+    crc = CRC16_Update(CRC16_INITIAL_VALUE, &bytes[FRAME_TYPE_INDEX], FRAME_HEADER_SIZE - 1 + Length);
+    bytes[FRAME_HEADER_SIZE + Length] = (uint8_t)(crc >> 8);
+    bytes[FRAME_HEADER_SIZE + Length + 1] = (uint8_t)crc;
+}
+
+/*
+ *@brief Validates a frame and fills the Record structure.
+ *@param frame Pointer to the complete frame.
+ *@param record_struct Pointer to the Record structure to be filled.
+ *@param data Buffer receiving the whole payload, at least FRAME_MAX_PAYLOAD bytes long.
+ *@returns The byte count of the equivalent S-record (payload length + FRAME_RECORD_OVERHEAD) if valid; 0 if invalid.
+ */
+uint8_t FRAME_Parse(volatile char *frame, Record *record_struct, uint8_t *data)
+{
+    const uint8_t *bytes = (const uint8_t *)frame;
+    uint8_t length = bytes[FRAME_LENGTH_INDEX];
+    uint8_t result = 0;
+    uint8_t i = 0;
+
+    if (FRAME_Check(frame))
+    {
+        record_struct->address = ((uint32_t)bytes[FRAME_ADDRESS_INDEX] << 24) | ((uint32_t)bytes[FRAME_ADDRESS_INDEX + 1] << 16) |
+                                 ((uint32_t)bytes[FRAME_ADDRESS_INDEX + 2] << 8) | bytes[FRAME_ADDRESS_INDEX + 3];
+        for (i = 0; i < length; i++)
+        {
+            data[i] = bytes[FRAME_HEADER_SIZE + i];
+        }
+        for (i = 0; i < 4; i++)
+        {
+            record_struct->data1[i] = data[i];
+            record_struct->data2[i] = data[4 + i];
+            record_struct->data3[i] = data[8 + i];
+            record_struct->data4[i] = data[12 + i];
+        }
+        result = length + FRAME_RECORD_OVERHEAD;
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+
+    return result;
+}
+
+/* EOF */
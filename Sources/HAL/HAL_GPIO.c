@@ -60,7 +60,7 @@ void HAL_GPIO_PDDR_Port_Data_Direction(GPIO_Type *GPIOx, uint8_t Pin, PDDR_PDD_e
  */
 void HAL_GPIO_PSOR_Port_Set_Output(GPIO_Type *GPIOx, uint8_t Pin, PSOR_PTSO_enum PinState)
 {
-    GPIOx->PSOR |= (1 << Pin); /* Set the pin to high state */
+    GPIOx->PSOR = (1u << Pin); /* Set the pin to high state, PSOR is write-only so no read-modify-write is needed */
 }
 
 /*
@@ -72,7 +72,7 @@ void HAL_GPIO_PSOR_Port_Set_Output(GPIO_Type *GPIOx, uint8_t Pin, PSOR_PTSO_enum
  */
 void HAL_GPIO_PCOR_Port_Clear_Output(GPIO_Type *GPIOx, uint8_t Pin, PCOR_PTCO_enum PinState)
 {
-    GPIOx->PCOR |= (1 << Pin); /* Set the pin to low state */
+    GPIOx->PCOR = (1u << Pin); /* Set the pin to low state, PCOR is write-only so no read-modify-write is needed */
 }
 
 /*
@@ -83,7 +83,7 @@ void HAL_GPIO_PCOR_Port_Clear_Output(GPIO_Type *GPIOx, uint8_t Pin, PCOR_PTCO_en
  */
 void HAL_GPIO_PTOR_Toggle_Output(GPIO_Type *GPIOx, uint8_t Pin)
 {
-    GPIOx->PTOR = (GPIOx->PTOR & ~GPIO_PTOR_PTTO_MASK) | GPIO_PTOR_PTTO(Pin);
+    GPIOx->PTOR = GPIO_PTOR_PTTO(1u << Pin); /* Toggle the pin, PTOR is write-only */
 }
 
 /*
@@ -130,4 +130,61 @@ PDOR_Output_Pin_State HAL_GPIO_PDOR_Read_Output_Pin(GPIO_Type *GPIOx, uint8_t Pi
     return pin_status; /* Return the state of the pin */
 }
 
+/*
+ *@brief Sets the output state of a GPIO pin to high through the FGPIO (IOPORT) alias.
+ *@param FGPIOx Pointer to the FGPIO base address.
+ *@param Pin The pin number to configure.
+ *@param PinState The desired pin state (not used in this function).
+ *@returns None
+ */
+void HAL_FGPIO_PSOR_Port_Set_Output(FGPIO_Type *FGPIOx, uint8_t Pin, PSOR_PTSO_enum PinState)
+{
+    FGPIOx->PSOR = FGPIO_PSOR_PTSO(1u << Pin); /* Single-cycle set of the pin */
+}
+
+/*
+ *@brief Clears the output state of a GPIO pin to low through the FGPIO (IOPORT) alias.
+ *@param FGPIOx Pointer to the FGPIO base address.
+ *@param Pin The pin number to configure.
+ *@param PinState The desired pin state (not used in this function).
+ *@returns None
+ */
+void HAL_FGPIO_PCOR_Port_Clear_Output(FGPIO_Type *FGPIOx, uint8_t Pin, PCOR_PTCO_enum PinState)
+{
+    FGPIOx->PCOR = FGPIO_PCOR_PTCO(1u << Pin); /* Single-cycle clear of the pin */
+}
+
+/*
+ *@brief Toggles the output state of a GPIO pin through the FGPIO (IOPORT) alias.
+ *@param FGPIOx Pointer to the FGPIO base address.
+ *@param Pin The pin number to toggle.
+ *@returns None
+ */
+void HAL_FGPIO_PTOR_Toggle_Output(FGPIO_Type *FGPIOx, uint8_t Pin)
+{
+    FGPIOx->PTOR = FGPIO_PTOR_PTTO(1u << Pin); /* Single-cycle toggle of the pin */
+}
+
+/*
+ *@brief Reads the data input state of a GPIO pin through the FGPIO (IOPORT) alias.
+ *@param FGPIOx Pointer to the FGPIO base address.
+ *@param Pin The pin number to read.
+ *@returns The current state of the pin (logic 0 or logic 1).
+ */
+PDIR_PDI_enum HAL_FGPIO_PDIR_Data_Input(FGPIO_Type *FGPIOx, uint8_t Pin)
+{
+    PDIR_PDI_enum bitstatus = PDIR_PDI_LOGIC_0;
+
+    if ((FGPIOx->PDIR >> Pin) & 1)
+    {
+        bitstatus = PDIR_PDI_LOGIC_1; /* The pin is in high state */
+    }
+    else
+    {
+        /* The pin is in low state */
+    }
+
+    return bitstatus; /* Return the state of the pin */
+}
+
 /* EOF */
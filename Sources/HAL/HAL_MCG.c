@@ -0,0 +1,50 @@
+/**
+ * @file HAL_MCG.c
+ * @brief  HAL functions for the MCG module.
+ * @details This file provides functions for selecting the FLL output range of the Multipurpose Clock Generator (MCG)
+ *          and reading its clock mode status.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/05
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "../Includes/HAL/HAL_MCG.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *@brief  Selects the FLL DCO range and maximum frequency with a single write, keeping the trim values.
+ *@param   dmx32  DCO maximum frequency selection.
+ *@param   range  DCO range selection.
+ *@returns None
+ */
+void HAL_MCG_C4_FLL_Range_Select(C4_DMX32_enum dmx32, C4_DRST_DRS_enum range)
+{
+    MCG->C4 = (MCG->C4 & ~(MCG_C4_DMX32_MASK | MCG_C4_DRST_DRS_MASK)) | MCG_C4_DMX32(dmx32) | MCG_C4_DRST_DRS(range);
+}
+
+/*
+ *@brief  Reads the clock mode status of the MCG output.
+ *@returns The clock source currently driving MCGOUTCLK.
+ */
+S_CLKST_enum HAL_MCG_S_Clock_Mode_Status(void)
+{
+    return (S_CLKST_enum)((MCG->S & MCG_S_CLKST_MASK) >> MCG_S_CLKST_SHIFT);
+}
+
+/* EOF */
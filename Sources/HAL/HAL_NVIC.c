@@ -47,4 +47,14 @@ void HAL_NVIC_Disable_External_Interrupt(IRQn_Type Type)
     NVIC_DisableIRQ(Type); /* Disable the external interrupt */
 }
 
+/*
+ *@brief Disable all external interrupts and clear their pending state.
+ *@returns No return value
+ */
+void HAL_NVIC_Disable_All_External_Interrupts(void)
+{
+    NVIC->ICER[0] = 0xFFFFFFFFu; /* Disable all 32 external interrupts */
+    NVIC->ICPR[0] = 0xFFFFFFFFu; /* Clear all pending external interrupts */
+}
+
 /* EOF */
@@ -74,6 +74,43 @@ void HAL_PORT_PCR_Interrupt_Configuration(PORT_Type *PORTx, uint8_t Pin, PCR_IRQ
 	PORTx->PCR[Pin] = (PORTx->PCR[Pin] & ~PORT_PCR_IRQC_MASK) | PORT_PCR_IRQC(Config);
 }
 
+/*
+ *@brief Updates several fields of a pin control register with a single read-modify-write.
+ *@param PORTx Pointer to the PORT peripheral base address.
+ *@param Pin Pin number to configure.
+ *@param Mask Mask of the PCR fields to update.
+ *@param Value New value of the fields selected by Mask.
+ *@returns None
+ */
+void HAL_PORT_PCR_Write_Fields(PORT_Type *PORTx, uint8_t Pin, uint32_t Mask, uint32_t Value)
+{
+	PORTx->PCR[Pin] = (PORTx->PCR[Pin] & ~(Mask | PORT_PCR_ISF_MASK)) | (Value & Mask); /* ISF is write-1-to-clear, keep it 0 */
+}
+
+/*
+ *@brief Writes the same PCR[15:0] value to several pins 0..15 with the Global Pin Control Low register.
+ *@param PORTx Pointer to the PORT peripheral base address.
+ *@param Pin_Mask Bit n selects pin n.
+ *@param Value Value written to bits 15:0 of each selected pin control register.
+ *@returns None
+ */
+void HAL_PORT_GPCLR_Global_Pin_Control_Low(PORT_Type *PORTx, uint16_t Pin_Mask, uint16_t Value)
+{
+	PORTx->GPCLR = PORT_GPCLR_GPWE(Pin_Mask) | PORT_GPCLR_GPWD(Value);
+}
+
+/*
+ *@brief Writes the same PCR[15:0] value to several pins 16..31 with the Global Pin Control High register.
+ *@param PORTx Pointer to the PORT peripheral base address.
+ *@param Pin_Mask Bit n selects pin 16 + n.
+ *@param Value Value written to bits 15:0 of each selected pin control register.
+ *@returns None
+ */
+void HAL_PORT_GPCHR_Global_Pin_Control_High(PORT_Type *PORTx, uint16_t Pin_Mask, uint16_t Value)
+{
+	PORTx->GPCHR = PORT_GPCHR_GPWE(Pin_Mask) | PORT_GPCHR_GPWD(Value);
+}
+
 /*
  *@brief Clears the interrupt status flag for a pin.
  *@param PORTx Pointer to the PORT peripheral base address.
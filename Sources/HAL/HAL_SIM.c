@@ -208,4 +208,86 @@ void HAL_SIM_SOPT2_UART0SRC_Clock_Source_Select(SOPT2_UART0SRC_enum select)
     SIM->SOPT2 = (SIM->SOPT2 & ~SIM_SOPT2_UART0SRC_MASK) | SIM_SOPT2_UART0SRC(select);
 }
 
+/*
+ *@brief  Sets the core/system and bus/flash clock dividers with a single write.
+ *@param   outdiv1  Core and system clock divide value minus one (0 = divide by 1).
+ *@param   outdiv4  Bus and flash clock divide value minus one, applied after OUTDIV1 (1 = divide by 2).
+ *@returns None
+ */
+void HAL_SIM_CLKDIV1_Clock_Dividers(uint8_t outdiv1, uint8_t outdiv4)
+{
+    SIM->CLKDIV1 = SIM_CLKDIV1_OUTDIV1(outdiv1) | SIM_CLKDIV1_OUTDIV4(outdiv4);
+}
+
+/*
+ *@brief  Enables several clock gates of the SCGC4 register with a single write.
+ *@param   mask  Mask of SIM_SCGC4_xxx_MASK bits to enable.
+ *@returns None
+ */
+void HAL_SIM_SCGC4_Clock_Gate_Enable_Mask(uint32_t mask)
+{
+    SIM->SCGC4 |= mask;
+}
+
+/*
+ *@brief  Enables several clock gates of the SCGC5 register with a single write.
+ *@param   mask  Mask of SIM_SCGC5_xxx_MASK bits to enable.
+ *@returns None
+ */
+void HAL_SIM_SCGC5_Clock_Gate_Enable_Mask(uint32_t mask)
+{
+    SIM->SCGC5 |= mask;
+}
+
+/*
+ *@brief  Enables several clock gates of the SCGC6 register with a single write.
+ *@param   mask  Mask of SIM_SCGC6_xxx_MASK bits to enable.
+ *@returns None
+ */
+void HAL_SIM_SCGC6_Clock_Gate_Enable_Mask(uint32_t mask)
+{
+    SIM->SCGC6 |= mask;
+}
+
+/*
+ *@brief  Disables several clock gates of the SCGC4 register with a single write.
+ *@param   mask  Mask of SIM_SCGC4_xxx_MASK bits to disable.
+ *@returns None
+ */
+void HAL_SIM_SCGC4_Clock_Gate_Disable_Mask(uint32_t mask)
+{
+    SIM->SCGC4 &= ~mask;
+}
+
+/*
+ *@brief  Disables several clock gates of the SCGC5 register with a single write.
+ *@param   mask  Mask of SIM_SCGC5_xxx_MASK bits to disable.
+ *@returns None
+ */
+void HAL_SIM_SCGC5_Clock_Gate_Disable_Mask(uint32_t mask)
+{
+    SIM->SCGC5 &= ~mask;
+}
+
+/*
+ *@brief  Disables several clock gates of the SCGC6 register with a single write.
+ *@param   mask  Mask of SIM_SCGC6_xxx_MASK bits to disable.
+ *@returns None
+ */
+void HAL_SIM_SCGC6_Clock_Gate_Disable_Mask(uint32_t mask)
+{
+    SIM->SCGC6 &= ~mask;
+}
+
+/*
+ *@brief  Updates several fields of the SOPT2 register with a single write.
+ *@param   mask   Mask of the SOPT2 fields to update.
+ *@param   value  New value of the fields selected by mask.
+ *@returns None
+ */
+void HAL_SIM_SOPT2_Write_Fields(uint32_t mask, uint32_t value)
+{
+    SIM->SOPT2 = (SIM->SOPT2 & ~mask) | (value & mask);
+}
+
 /* EOF */
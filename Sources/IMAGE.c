@@ -0,0 +1,521 @@
+/**
+ * @file IMAGE.c
+ * @brief Functions for handling the application image header.
+ * @details This file contains the functions to parse the image header from the S0 header record of the update
+ *          stream, compute the CRC-32 of the image in flash, hash the image with SHA-256 while it is received,
+ *          program the header once the image has been written, and check the installed image against the header
+ *          at boot.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stddef.h>
+#include "IMAGE.h"
+#include "FLASH.h"
+#include "CRC32.h"
+#include "SIGNING_KEY.h"
+#include "ENCRYPTION_KEY.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define IMAGE_MIN_LENGTH 8u /* At least the initial MSP and the reset vector */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint32_t IMAGE_Stream_Base = APPLICATION_ADDRESS; /* Slot being updated, image offset 0 */
+#if BOOT_FEATURE_SIGNATURE
+static SHA256_Context IMAGE_Stream_Hash;  /* SHA-256 of the image being received */
+static uint32_t IMAGE_Stream_End = 0;     /* Address following the last byte hashed */
+static uint8_t IMAGE_Stream_In_Order = 0; /* 0 once data went backwards and the digest must come from flash */
+static ECDSA_P256_Context IMAGE_Signature;  /* Signature verification of the image being received */
+static const uint8_t IMAGE_Signing_Public_Key[ECDSA_P256_KEY_SIZE] = SIGNING_KEY_PUBLIC_KEY;
+#endif
+#if BOOT_FEATURE_ENCRYPTION
+static const uint8_t IMAGE_Encryption_Key[AES128_KEY_SIZE] = ENCRYPTION_KEY_AES128;
+static AES128_CTR_Context IMAGE_Cipher;   /* Key stream of the image being received */
+static uint8_t IMAGE_Decrypt_Enabled = 0; /* 1 once the stream announced an encrypted image */
+#endif
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+#if BOOT_FEATURE_SIGNATURE
+/*
+ *@brief Hashes erased flash (0xFF) up to the given address.
+ *@param End Address the stream must reach.
+ */
+static void IMAGE_Stream_Pad(uint32_t End);
+#endif
+
+/*
+ *@brief Returns the current boot log.
+ *@returns Pointer to the log with a complete identity and the highest sequence; NULL if there is none.
+ */
+static const volatile Image_Boot_Log *IMAGE_Boot_Log_Current(void);
+
+/*
+ *@brief Starts a new boot log for the image of a header and logs a full check. Interrupts must be disabled by the caller.
+ *@param Current Pointer to the current log, NULL if there is none.
+ *@param Header Pointer to the header of the image in flash.
+ */
+static void IMAGE_Boot_Log_Start(const volatile Image_Boot_Log *Current, const volatile Image_Header *Header);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *@brief Combines four big-endian bytes into a 32-bit value.
+ *@param data Pointer to the four bytes.
+ *@returns The 32-bit value.
+ */
+uint32_t IMAGE_Bytes_To_Word(const uint8_t *data)
+{
+    return ((uint32_t)data[0] << 24) | ((uint32_t)data[1] << 16) | ((uint32_t)data[2] << 8) | (uint32_t)data[3];
+}
+
+/*
+ *@brief Fills an image header from a parsed S0 header record.
+ *@details Records that do not describe an image fitting the slot being updated (for example the module name S0 record
+ *         emitted by objcopy) are rejected, so a plain S-record file keeps working.
+ *@param record_struct Pointer to the parsed S0 record.
+ *@param byteCount_in_record The byte count in the record.
+ *@param Load_Address Address of the slot being updated.
+ *@param Header Pointer to the header to fill.
+ *@returns 1 if the record is an image header; 0 otherwise.
+ */
+uint8_t IMAGE_Parse_Header_Record(const Record *record_struct, uint8_t byteCount_in_record, uint32_t Load_Address, Image_Header *Header)
+{
+    uint8_t result = 0;
+    uint32_t image_length = IMAGE_Bytes_To_Word(record_struct->data1);
+    uint32_t load_address = IMAGE_Bytes_To_Word(record_struct->data2);
+
+    if (IMAGE_HEADER_RECORD_BYTE_COUNT == byteCount_in_record && IMAGE_RECORD_TAG_HEADER == record_struct->address &&
+        Load_Address == load_address &&
+        IMAGE_MIN_LENGTH <= image_length && IMAGE_SLOT_SIZE >= image_length)
+    {
+        Header->Magic = IMAGE_HEADER_MAGIC;
+        Header->Image_Length = image_length;
+        Header->Load_Address = load_address;
+        Header->Image_Version = IMAGE_Bytes_To_Word(record_struct->data3);
+        Header->Image_CRC32 = IMAGE_Bytes_To_Word(record_struct->data4);
+        result = 1;
+    }
+    else
+    {
+        /* Not an image header */
+    }
+
+    return result;
+}
+
+/*
+ *@brief Returns the number of flash sectors an image of the given length occupies.
+ *@param Image_Length Image length in bytes.
+ *@returns Number of sectors from the start of the slot.
+ */
+uint8_t IMAGE_Sectors_Required(uint32_t Image_Length)
+{
+    return (uint8_t)((Image_Length + IMAGE_SECTOR_SIZE - 1u) / IMAGE_SECTOR_SIZE);
+}
+
+/*
+ *@brief Computes the CRC-32 of a memory-mapped flash region.
+ *@param Address Start address.
+ *@param Length Number of bytes.
+ *@returns The CRC-32 (IEEE 802.3) of the region.
+ */
+uint32_t IMAGE_Compute_CRC32(uint32_t Address, uint32_t Length)
+{
+    return CRC32_Compute((const uint8_t *)Address, Length);
+}
+
+/*
+ *@brief Programs the image header into the erased header sector of the slot at its Load_Address.
+ *@details The fields are programmed first and `Magic` last. Interrupts must be disabled by the caller.
+ *@param Header Pointer to the header to program; its Magic field is ignored.
+ *@returns 1 if success.
+ */
+uint8_t IMAGE_Write_Header(const Image_Header *Header)
+{
+    Image_Header *flash_header = (Image_Header *)IMAGE_SLOT_HEADER_ADDRESS(Header->Load_Address);
+
+    Program_LongWord((uint32_t)&flash_header->Image_Length, Header->Image_Length);
+    Program_LongWord((uint32_t)&flash_header->Load_Address, Header->Load_Address);
+    Program_LongWord((uint32_t)&flash_header->Image_Version, Header->Image_Version);
+    Program_LongWord((uint32_t)&flash_header->Image_CRC32, Header->Image_CRC32);
+    Program_LongWord((uint32_t)&flash_header->Magic, IMAGE_HEADER_MAGIC); /* Commit point of the update */
+
+    return 1;
+}
+
+/*
+ *@brief Checks that an installed image is the base a delta patch was built against.
+ *@param Load_Address Address of the slot holding the base image.
+ *@param Length Length of the base image.
+ *@param CRC32 CRC-32 of the base image.
+ *@returns 1 if the installed header and the flash contents match the base; 0 otherwise.
+ */
+uint8_t IMAGE_Check_Patch_Base(uint32_t Load_Address, uint32_t Length, uint32_t CRC32)
+{
+    const volatile Image_Header *flash_header = (const volatile Image_Header *)IMAGE_SLOT_HEADER_ADDRESS(Load_Address);
+    uint8_t match = 0;
+
+    if (IMAGE_HEADER_MAGIC == flash_header->Magic && Load_Address == flash_header->Load_Address &&
+        Length == flash_header->Image_Length && CRC32 == flash_header->Image_CRC32 && IMAGE_SLOT_SIZE >= Length)
+    {
+        match = (CRC32 == IMAGE_Compute_CRC32(Load_Address, Length)) ? 1 : 0; /* The header alone is not enough */
+    }
+    else
+    {
+        /* No image, or another one */
+    }
+
+    return match;
+}
+
+#if BOOT_FEATURE_SIGNATURE
+/*
+ *@brief Hashes erased flash (0xFF) up to the given address.
+ *@param End Address the stream must reach.
+ */
+static void IMAGE_Stream_Pad(uint32_t End)
+{
+    static const uint8_t erased[16] = {0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu,
+                                       0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu, 0xFFu};
+    uint32_t length = 0;
+
+    while (End > IMAGE_Stream_End)
+    {
+        length = End - IMAGE_Stream_End;
+        if (sizeof(erased) < length)
+        {
+            length = sizeof(erased);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        SHA256_Update(&IMAGE_Stream_Hash, erased, length);
+        IMAGE_Stream_End += length;
+    }
+}
+#endif
+
+/*
+ *@brief Starts the SHA-256 of the image being received.
+ *@details The digest covers Image_Length bytes from Load_Address, as they end up in flash. In the update stream the
+ *         expected digest is carried by an S0 record with a byte count of 0x23, sent after the header record.
+ *         Without BOOT_FEATURE_SIGNATURE nothing is hashed.
+ *@param Load_Address Address of the slot being updated.
+ */
+void IMAGE_Stream_Start(uint32_t Load_Address)
+{
+    IMAGE_Stream_Base = Load_Address;
+#if BOOT_FEATURE_SIGNATURE
+    SHA256_Init(&IMAGE_Stream_Hash);
+    IMAGE_Stream_End = Load_Address;
+    IMAGE_Stream_In_Order = 1;
+    IMAGE_Signature.Status = ECDSA_IDLE;
+#endif
+#if BOOT_FEATURE_ENCRYPTION
+    IMAGE_Decrypt_Enabled = 0;
+#endif
+}
+
+#if BOOT_FEATURE_ENCRYPTION
+/*
+ *@brief Enables the decryption of the image being received.
+ *@details Encrypted images are AES-128-CTR encrypted over the image bytes: the key stream block of image offset o is
+ *         AES(Initial_Counter + o / 16), the counter being a 128-bit big-endian number. The key stream therefore
+ *         depends only on the address of the data, so records can arrive out of order or be sent again.
+ *         In the update stream the initial counter is carried by an S0 record with a byte count of 0x13 and the
+ *         address field IMAGE_RECORD_TAG_COUNTER, sent before the first data record.
+ *@param Initial_Counter Pointer to the AES128_BLOCK_SIZE byte counter of image offset 0.
+ */
+void IMAGE_Decrypt_Start(const uint8_t *Initial_Counter)
+{
+    AES128_CTR_Init(&IMAGE_Cipher, IMAGE_Encryption_Key, Initial_Counter);
+    IMAGE_Decrypt_Enabled = 1;
+}
+#endif
+
+/*
+ *@brief Decrypts data of the image being received in place, if decryption is enabled.
+ *@details Does nothing without BOOT_FEATURE_ENCRYPTION.
+ *@param Address Flash address of the data, inside the slot being updated.
+ *@param Data Pointer to the data.
+ *@param Length Number of bytes.
+ */
+void IMAGE_Decrypt(uint32_t Address, uint8_t *Data, uint32_t Length)
+{
+#if BOOT_FEATURE_ENCRYPTION
+    if (0 != IMAGE_Decrypt_Enabled)
+    {
+        AES128_CTR_Crypt(&IMAGE_Cipher, Address - IMAGE_Stream_Base, Data, Length);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+#else
+    (void)Address;
+    (void)Data;
+    (void)Length;
+#endif
+}
+
+/*
+ *@brief Feeds data programmed into the application slot to the image SHA-256.
+ *@details Data following the previous data is hashed immediately. A gap is hashed as erased flash (0xFF). Data going
+ *         backwards (retransmitted or out of order records) cannot be streamed; the digest is then computed over
+ *         flash by IMAGE_Stream_Check_Digest. Does nothing without BOOT_FEATURE_SIGNATURE.
+ *@param Address Flash address of the data.
+ *@param Data Pointer to the data.
+ *@param Length Number of bytes.
+ */
+void IMAGE_Stream_Data(uint32_t Address, const uint8_t *Data, uint32_t Length)
+{
+#if BOOT_FEATURE_SIGNATURE
+    if (0 == IMAGE_Stream_In_Order || IMAGE_Stream_End > Address)
+    {
+        IMAGE_Stream_In_Order = 0;
+    }
+    else
+    {
+        IMAGE_Stream_Pad(Address);
+        SHA256_Update(&IMAGE_Stream_Hash, Data, Length);
+        IMAGE_Stream_End += Length;
+    }
+#else
+    (void)Address;
+    (void)Data;
+    (void)Length;
+#endif
+}
+
+/*
+ *@brief Finishes the image SHA-256 and compares it with the expected digest.
+ *@param Header Pointer to the header of the received image.
+ *@param Expected_Digest Pointer to the SHA256_DIGEST_SIZE byte digest from the digest record.
+ *@returns 1 if the digests match; 0 otherwise, always 0 without BOOT_FEATURE_SIGNATURE.
+ */
+uint8_t IMAGE_Stream_Check_Digest(const Image_Header *Header, const uint8_t *Expected_Digest)
+{
+#if BOOT_FEATURE_SIGNATURE
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    uint8_t difference = 0;
+    uint8_t i = 0;
+    uint32_t image_end = Header->Load_Address + Header->Image_Length;
+
+    if (0 == IMAGE_Stream_In_Order || image_end < IMAGE_Stream_End)
+    {
+        /* The stream does not match the image: second pass over flash */
+        SHA256_Init(&IMAGE_Stream_Hash);
+        SHA256_Update(&IMAGE_Stream_Hash, (const uint8_t *)Header->Load_Address, Header->Image_Length);
+    }
+    else
+    {
+        IMAGE_Stream_Pad(image_end); /* Erased tail up to the image length */
+    }
+    SHA256_Final(&IMAGE_Stream_Hash, digest);
+
+    for (i = 0; i < SHA256_DIGEST_SIZE; i++)
+    {
+        difference |= digest[i] ^ Expected_Digest[i];
+    }
+#else
+    uint8_t difference = 1; /* Nothing was hashed */
+
+    (void)Header;
+    (void)Expected_Digest;
+#endif
+
+    return (0 == difference) ? 1 : 0;
+}
+
+#if BOOT_FEATURE_SIGNATURE
+
+/*
+ *@brief Starts the verification of the image signature.
+ *@details The signature is over the expected image digest, so it can be verified while the image is still being
+ *         received; IMAGE_Stream_Check_Digest then ties the received image to that digest. In the update stream
+ *         r and s are carried by two S0 records with a byte count of 0x23, tagged by their address field.
+ *@param Digest Pointer to the expected SHA-256 of the image.
+ *@param Signature Pointer to the signature, r || s big-endian.
+ */
+void IMAGE_Signature_Start(const uint8_t *Digest, const uint8_t *Signature)
+{
+    ECDSA_P256_Verify_Start(&IMAGE_Signature, IMAGE_Signing_Public_Key, Digest, Signature);
+}
+#endif
+
+/*
+ *@brief Runs one step of the signature verification, if one is in progress.
+ *@details Called from the update loop after the pending records. UART0 keeps receiving in its interrupt while a
+ *         step runs. The heaviest step, one doubling and two additions, is 30 Montgomery multiplications or about
+ *         5.3 ms at 47.97 MHz (tools/ecdsa_bench), and IMAGE_Signature_Start about 6 ms; UART0 takes 30.6 ms at
+ *         115200 baud, 7.6 ms at 460800 baud, to fill the record queue with 16-byte S1 records.
+ *@returns ECDSA_IDLE if no verification was started or without BOOT_FEATURE_SIGNATURE, ECDSA_BUSY, ECDSA_VALID or
+ *         ECDSA_INVALID.
+ */
+ECDSA_Status IMAGE_Signature_Step(void)
+{
+#if BOOT_FEATURE_SIGNATURE
+    return ECDSA_P256_Verify_Step(&IMAGE_Signature);
+#else
+    return ECDSA_IDLE;
+#endif
+}
+
+/*
+ *@brief Completes the signature verification.
+ *@returns ECDSA_IDLE if no verification was started or without BOOT_FEATURE_SIGNATURE, ECDSA_VALID or ECDSA_INVALID.
+ */
+ECDSA_Status IMAGE_Signature_Finish(void)
+{
+#if BOOT_FEATURE_SIGNATURE
+    while (ECDSA_BUSY == ECDSA_P256_Verify_Step(&IMAGE_Signature))
+    {
+        /* Remaining steps, usually none: the verification ran during the transfer */
+    }
+
+    return IMAGE_Signature.Status;
+#else
+    return ECDSA_IDLE;
+#endif
+}
+
+/*
+ *@brief Returns the current boot log.
+ *@returns Pointer to the log with a complete identity and the highest sequence; NULL if there is none.
+ */
+static const volatile Image_Boot_Log *IMAGE_Boot_Log_Current(void)
+{
+    const volatile Image_Boot_Log *current = NULL;
+    const volatile Image_Boot_Log *log = NULL;
+    uint8_t i = 0;
+
+    for (i = 0; i < IMAGE_BOOT_LOG_SECTORS; i++)
+    {
+        log = (const volatile Image_Boot_Log *)(IMAGE_BOOT_LOG_ADDRESS + i * IMAGE_SECTOR_SIZE);
+        if (IMAGE_BOOT_LOG_MAGIC == log->Magic && (NULL == current || 0 < (int32_t)(log->Sequence - current->Sequence)))
+        {
+            current = log;
+        }
+        else
+        {
+            /* Erased, interrupted while started, or older */
+        }
+    }
+
+    return current;
+}
+
+/*
+ *@brief Starts a new boot log for the image of a header and logs a full check. Interrupts must be disabled by the caller.
+ *@details The log is started in the sector not holding the current one, which stays valid until Magic is programmed.
+ *@param Current Pointer to the current log, NULL if there is none.
+ *@param Header Pointer to the header of the image in flash.
+ */
+static void IMAGE_Boot_Log_Start(const volatile Image_Boot_Log *Current, const volatile Image_Header *Header)
+{
+    const volatile Image_Boot_Log *log = (const volatile Image_Boot_Log *)IMAGE_BOOT_LOG_ADDRESS;
+    uint32_t sequence = 0;
+
+    if (NULL != Current)
+    {
+        sequence = Current->Sequence + 1u;
+        if (log == Current)
+        {
+            log = (const volatile Image_Boot_Log *)(IMAGE_BOOT_LOG_ADDRESS + IMAGE_SECTOR_SIZE);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        /* First log */
+    }
+    Erase_Sector((uint32_t)log);
+    Program_LongWord((uint32_t)&log->Sequence, sequence);
+    Program_LongWord((uint32_t)&log->Load_Address, Header->Load_Address);
+    Program_LongWord((uint32_t)&log->Image_CRC32, Header->Image_CRC32);
+    Program_LongWord((uint32_t)&log->Magic, IMAGE_BOOT_LOG_MAGIC); /* The new log replaces the current one */
+    Program_LongWord((uint32_t)&log->Entries[0], IMAGE_BOOT_LOG_FULL_CHECK);
+}
+
+/*
+ *@brief Checks the image installed in a slot against its header in flash and records the boot in the boot log.
+ *@details The header must be complete and describe an image loaded at Load_Address that fits the slot.
+ *         The CRC over exactly Image_Length bytes of the image is then checked on the first boot after an update and
+ *         every `IMAGE_REVERIFY_INTERVAL` boots; the boots in between trust the last full check. When the boot log
+ *         is full, or belongs to another image, a new one is started after a successful full check.
+ *         Interrupts are disabled while the log is programmed, then left masked if they were on entry.
+ *@param Load_Address Address of the slot.
+ *@returns IMAGE_VALID, IMAGE_INVALID_HEADER or IMAGE_INVALID_CRC.
+ */
+BOOT_Image_Status IMAGE_Check_Installed_Image(uint32_t Load_Address)
+{
+    const volatile Image_Header *header = (const volatile Image_Header *)IMAGE_SLOT_HEADER_ADDRESS(Load_Address);
+    const volatile Image_Boot_Log *log = IMAGE_Boot_Log_Current();
+    BOOT_Image_Status status = IMAGE_VALID;
+    uint8_t logged = 0; /* The current log belongs to this image */
+    uint32_t boot_index = 0;
+    uint32_t primask = __get_PRIMASK(); /* Masked when called before the C runtime init */
+
+    if (NULL != log && Load_Address == log->Load_Address && header->Image_CRC32 == log->Image_CRC32)
+    {
+        logged = 1;
+        /* Boots since the log started, up to the first unused entry */
+        while (IMAGE_BOOT_LOG_WORDS > boot_index && 0xFFFFFFFFu != log->Entries[boot_index])
+        {
+            boot_index++;
+        }
+    }
+    else
+    {
+        /* First boot of this image since it was installed or booted last */
+    }
+
+    if (IMAGE_HEADER_MAGIC != header->Magic || Load_Address != header->Load_Address ||
+        IMAGE_MIN_LENGTH > header->Image_Length || IMAGE_SLOT_SIZE < header->Image_Length)
+    {
+        status = IMAGE_INVALID_HEADER;
+    }
+    else if (logged && 0 != (boot_index % IMAGE_REVERIFY_INTERVAL) && IMAGE_BOOT_LOG_WORDS > boot_index)
+    {
+        __disable_irq();
+        Program_LongWord((uint32_t)&log->Entries[boot_index], IMAGE_BOOT_LOG_QUICK_CHECK);
+        __set_PRIMASK(primask);
+    }
+    else if (header->Image_CRC32 != IMAGE_Compute_CRC32(header->Load_Address, header->Image_Length))
+    {
+        status = IMAGE_INVALID_CRC; /* Not logged, so the next boot checks again */
+    }
+    else if (logged && IMAGE_BOOT_LOG_WORDS > boot_index)
+    {
+        __disable_irq();
+        Program_LongWord((uint32_t)&log->Entries[boot_index], IMAGE_BOOT_LOG_FULL_CHECK);
+        __set_PRIMASK(primask);
+    }
+    else
+    {
+        /* Log full or of another image: start a new one, the image was just verified */
+        __disable_irq();
+        IMAGE_Boot_Log_Start(log, header);
+        __set_PRIMASK(primask);
+    }
+
+    return status;
+}
+/* EOF */
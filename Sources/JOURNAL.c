@@ -0,0 +1,216 @@
+/**
+ * @file JOURNAL.c
+ * @brief Update progress journal.
+ * @details This file contains the functions that keep and read the journal of completed sectors. Entries are only
+ *          ever appended to the erased words of the journal sector, so recording progress costs no erase cycles; the
+ *          sector is erased once per update, and once more when a resumed update finds a stale entry.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "JOURNAL.h"
+#include "FLASH.h"
+#include "CRC16.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define JOURNAL_UNUSED 0xFFFFFFFFu /* Erased entry */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint8_t JOURNAL_Active = 0;     /* 1 while the journal describes the image being received */
+static uint32_t JOURNAL_Base = 0;      /* Slot being updated, Load_Address of the identity */
+static uint32_t JOURNAL_Completed = 0; /* Sectors recorded so far, also the index of the next entry */
+static uint16_t JOURNAL_Written[JOURNAL_SLOT_SECTORS]; /* Bytes programmed in each sector from JOURNAL_Completed on */
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief Computes the journal entry of an application sector from its flash contents.
+ *@param Sector Sector index from the start of the slot being updated.
+ *@returns The entry word.
+ */
+static uint32_t JOURNAL_Entry(uint32_t Sector);
+
+/*
+ *@brief Clears the counts of bytes programmed.
+ */
+static void JOURNAL_Clear_Written(void);
+
+/*
+ *@brief Rewrites the journal with the sectors verified so far.
+ *@param Identity Pointer to the header announced by the new session.
+ */
+static void JOURNAL_Restart(const Image_Header *Identity);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *@brief Computes the journal entry of an application sector from its flash contents.
+ *@param Sector Sector index from the start of the slot being updated.
+ *@returns The entry word.
+ */
+static uint32_t JOURNAL_Entry(uint32_t Sector)
+{
+    uint16_t crc = CRC16_Update(CRC16_INITIAL_VALUE, (const uint8_t *)(JOURNAL_Base + Sector * IMAGE_SECTOR_SIZE),
+                                IMAGE_SECTOR_SIZE);
+
+    return ((uint32_t)crc << 16) | ((~Sector & 0xFFu) << 8) | (Sector & 0xFFu);
+}
+
+/*
+ *@brief Clears the counts of bytes programmed.
+ */
+static void JOURNAL_Clear_Written(void)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < JOURNAL_SLOT_SECTORS; i++)
+    {
+        JOURNAL_Written[i] = 0;
+    }
+}
+
+/*
+ *@brief Rewrites the journal with the sectors verified so far.
+ *@details An entry that no longer matches its sector cannot be reprogrammed in place, so the journal is started over
+ *         and the entries of the sectors before it are appended again. An interruption meanwhile only loses them.
+ *@param Identity Pointer to the header announced by the new session.
+ */
+static void JOURNAL_Restart(const Image_Header *Identity)
+{
+    Journal_Sector *journal = (Journal_Sector *)JOURNAL_ADDRESS;
+    uint32_t kept = JOURNAL_Completed;
+    uint32_t entry = 0;
+    uint32_t sector = 0;
+
+    __disable_irq();
+    JOURNAL_Start(Identity);
+    __enable_irq();
+    for (sector = 0; sector < kept; sector++)
+    {
+        entry = JOURNAL_Entry(sector);
+        __disable_irq();
+        Program_LongWord((uint32_t)&journal->Entries[sector], entry);
+        __enable_irq();
+    }
+    JOURNAL_Completed = kept;
+}
+
+/*
+ *@brief Finds where an update of the given image can resume.
+ *@param Identity Pointer to the header announced by the new session.
+ *@returns Address of the first sector to receive again; Identity->Load_Address if nothing can be kept.
+ */
+uint32_t JOURNAL_Resume_Point(const Image_Header *Identity)
+{
+    const volatile Journal_Sector *journal = (const volatile Journal_Sector *)JOURNAL_ADDRESS;
+
+    JOURNAL_Active = 0;
+    JOURNAL_Completed = 0;
+    JOURNAL_Base = Identity->Load_Address;
+    JOURNAL_Clear_Written();
+    if (JOURNAL_MAGIC == journal->Identity.Magic && Identity->Image_Length == journal->Identity.Image_Length &&
+        Identity->Load_Address == journal->Identity.Load_Address && Identity->Image_Version == journal->Identity.Image_Version &&
+        Identity->Image_CRC32 == journal->Identity.Image_CRC32)
+    {
+        JOURNAL_Active = 1;
+        while (JOURNAL_ENTRIES > JOURNAL_Completed && JOURNAL_Entry(JOURNAL_Completed) == journal->Entries[JOURNAL_Completed])
+        {
+            JOURNAL_Completed++; /* Sector intact since it was recorded */
+        }
+        if (JOURNAL_ENTRIES > JOURNAL_Completed && JOURNAL_UNUSED != journal->Entries[JOURNAL_Completed])
+        {
+            JOURNAL_Restart(Identity); /* Stale entry: the sector after the kept ones is received again */
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        /* Another image, or no interrupted update */
+    }
+
+    return JOURNAL_Base + JOURNAL_Completed * IMAGE_SECTOR_SIZE;
+}
+
+/*
+ *@brief Starts a new journal for the given image.
+ *@param Identity Pointer to the header of the image being received.
+ */
+void JOURNAL_Start(const Image_Header *Identity)
+{
+    Journal_Sector *journal = (Journal_Sector *)JOURNAL_ADDRESS;
+
+    Erase_Sector(JOURNAL_ADDRESS);
+    Program_LongWord((uint32_t)&journal->Identity.Image_Length, Identity->Image_Length);
+    Program_LongWord((uint32_t)&journal->Identity.Load_Address, Identity->Load_Address);
+    Program_LongWord((uint32_t)&journal->Identity.Image_Version, Identity->Image_Version);
+    Program_LongWord((uint32_t)&journal->Identity.Image_CRC32, Identity->Image_CRC32);
+    Program_LongWord((uint32_t)&journal->Identity.Magic, JOURNAL_MAGIC);
+    JOURNAL_Active = 1;
+    JOURNAL_Completed = 0;
+    JOURNAL_Base = Identity->Load_Address;
+    JOURNAL_Clear_Written();
+}
+
+/*
+ *@brief Counts bytes programmed into the slot being updated and records the sectors completed.
+ *@param Address Address of the first byte programmed.
+ *@param Length Number of bytes programmed, each counted once.
+ */
+void JOURNAL_Record_Progress(uint32_t Address, uint32_t Length)
+{
+    Journal_Sector *journal = (Journal_Sector *)JOURNAL_ADDRESS;
+    uint32_t sector = 0;
+    uint32_t count = 0;
+
+    while (0 != Length && JOURNAL_Base <= Address && JOURNAL_Base + IMAGE_SLOT_SIZE > Address)
+    {
+        sector = (Address - JOURNAL_Base) / IMAGE_SECTOR_SIZE;
+        count = IMAGE_SECTOR_SIZE - (Address - JOURNAL_Base) % IMAGE_SECTOR_SIZE; /* Bytes left in the sector */
+        if (count > Length)
+        {
+            count = Length;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        JOURNAL_Written[sector] += (uint16_t)count;
+        Address += count;
+        Length -= count;
+    }
+
+    while (JOURNAL_Active && JOURNAL_ENTRIES > JOURNAL_Completed && JOURNAL_SLOT_SECTORS > JOURNAL_Completed &&
+           IMAGE_SECTOR_SIZE <= JOURNAL_Written[JOURNAL_Completed])
+    {
+        __disable_irq();
+        Program_LongWord((uint32_t)&journal->Entries[JOURNAL_Completed], JOURNAL_Entry(JOURNAL_Completed));
+        __enable_irq();
+        JOURNAL_Completed++;
+    }
+}
+
+/*
+ *@brief Erases the journal once the image is committed.
+ */
+void JOURNAL_Clear(void)
+{
+    Erase_Sector(JOURNAL_ADDRESS);
+    JOURNAL_Active = 0;
+}
+
+/* EOF */
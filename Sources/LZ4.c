@@ -0,0 +1,434 @@
+/**
+ * @file LZ4.c
+ * @brief Streaming LZ4 frame decoder.
+ * @details This file contains a byte-at-a-time decoder for the LZ4 frame format. Each input byte advances a small state
+ *          machine; literals are output as they arrive and a match is expanded as soon as its length is known, by
+ *          reading each byte back through the history callback. Overlapping matches (offset smaller than the length)
+ *          work because every copied byte is output before the next one is read back.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "LZ4.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define LZ4_FRAME_MAGIC 0x184D2204u         /* Frame magic number, little-endian in the stream */
+#define LZ4_FLG_VERSION_MASK 0xC0u          /* FLG version field */
+#define LZ4_FLG_VERSION_01 0x40u            /* The only defined version */
+#define LZ4_FLG_BLOCK_CHECKSUM 0x10u        /* Each block is followed by a 4-byte checksum */
+#define LZ4_FLG_CONTENT_SIZE 0x08u          /* The descriptor carries an 8-byte content size */
+#define LZ4_FLG_CONTENT_CHECKSUM 0x04u      /* The end mark is followed by a 4-byte checksum */
+#define LZ4_FLG_DICTIONARY_ID 0x01u         /* The descriptor carries a dictionary ID, not supported */
+#define LZ4_BLOCK_UNCOMPRESSED 0x80000000u  /* Block size flag: the block is stored as is */
+#define LZ4_LENGTH_EXTENDED 15u             /* Token nibble value announcing extra length bytes */
+#define LZ4_LENGTH_BYTE_CONTINUES 255u      /* Extra length byte value announcing one more byte */
+#define LZ4_MIN_MATCH 4u                    /* Match length encoded as an offset from this */
+
+/*
+ *@brief Decoder states.
+ */
+enum
+{
+    LZ4_STATE_MAGIC,             /* Frame magic number */
+    LZ4_STATE_FLG,               /* Frame descriptor FLG byte */
+    LZ4_STATE_BD,                /* Frame descriptor BD byte */
+    LZ4_STATE_SKIP,              /* Content size, header checksum or block checksum, then a block size */
+    LZ4_STATE_BLOCK_SIZE,        /* Block size or end mark */
+    LZ4_STATE_RAW,               /* Uncompressed block data */
+    LZ4_STATE_TOKEN,             /* Sequence token */
+    LZ4_STATE_LITERAL_LENGTH,    /* Extra literal length bytes */
+    LZ4_STATE_LITERALS,          /* Literal bytes */
+    LZ4_STATE_OFFSET,            /* Match offset */
+    LZ4_STATE_MATCH_LENGTH,      /* Extra match length bytes */
+    LZ4_STATE_CONTENT_CHECKSUM,  /* Content checksum after the end mark */
+    LZ4_STATE_DONE,              /* Frame complete */
+    LZ4_STATE_ERROR,             /* Decoding failed */
+};
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief Expects a new little-endian field of Count bytes in the given state.
+ *@param Context Pointer to the context.
+ *@param State The state collecting the field.
+ *@param Count Number of bytes of the field.
+ */
+static void LZ4_Expect_Field(LZ4_Context *Context, uint8_t State, uint8_t Count);
+
+/*
+ *@brief Ends the current block: skips its checksum if present, then expects the next block size.
+ *@param Context Pointer to the context.
+ */
+static void LZ4_End_Block(LZ4_Context *Context);
+
+/*
+ *@brief Continues after the literal length of a sequence is known.
+ *@param Context Pointer to the context.
+ */
+static void LZ4_Start_Literals(LZ4_Context *Context);
+
+/*
+ *@brief Continues after the literals of a sequence: the block ends or a match offset follows.
+ *@param Context Pointer to the context.
+ */
+static void LZ4_End_Literals(LZ4_Context *Context);
+
+/*
+ *@brief Expands the current match and expects the next sequence.
+ *@param Context Pointer to the context.
+ */
+static void LZ4_Copy_Match(LZ4_Context *Context);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *@brief Expects a new little-endian field of Count bytes in the given state.
+ *@param Context Pointer to the context.
+ *@param State The state collecting the field.
+ *@param Count Number of bytes of the field.
+ */
+static void LZ4_Expect_Field(LZ4_Context *Context, uint8_t State, uint8_t Count)
+{
+    Context->State = State;
+    Context->Count = Count;
+    Context->Value = 0;
+}
+
+/*
+ *@brief Ends the current block: skips its checksum if present, then expects the next block size.
+ *@param Context Pointer to the context.
+ */
+static void LZ4_End_Block(LZ4_Context *Context)
+{
+    if (Context->Flags & LZ4_FLG_BLOCK_CHECKSUM)
+    {
+        LZ4_Expect_Field(Context, LZ4_STATE_SKIP, 4u);
+    }
+    else
+    {
+        LZ4_Expect_Field(Context, LZ4_STATE_BLOCK_SIZE, 4u);
+    }
+}
+
+/*
+ *@brief Continues after the literal length of a sequence is known.
+ *@param Context Pointer to the context.
+ */
+static void LZ4_Start_Literals(LZ4_Context *Context)
+{
+    if (0u != Context->Length)
+    {
+        Context->State = LZ4_STATE_LITERALS;
+    }
+    else
+    {
+        LZ4_End_Literals(Context);
+    }
+}
+
+/*
+ *@brief Continues after the literals of a sequence: the block ends or a match offset follows.
+ *@param Context Pointer to the context.
+ */
+static void LZ4_End_Literals(LZ4_Context *Context)
+{
+    if (0u == Context->Block_Remaining)
+    {
+        LZ4_End_Block(Context); /* The last sequence of a block has literals only */
+    }
+    else
+    {
+        LZ4_Expect_Field(Context, LZ4_STATE_OFFSET, 2u);
+    }
+}
+
+/*
+ *@brief Expands the current match and expects the next sequence.
+ *@param Context Pointer to the context.
+ */
+static void LZ4_Copy_Match(LZ4_Context *Context)
+{
+    if (0u == Context->Offset || Context->Produced < Context->Offset)
+    {
+        Context->State = LZ4_STATE_ERROR; /* Match before the start of the output */
+    }
+    else
+    {
+        Context->Produced += Context->Length;
+        while (0u != Context->Length)
+        {
+            Context->Output(Context->History(Context->Offset));
+            Context->Length--;
+        }
+        Context->State = LZ4_STATE_TOKEN;
+    }
+}
+
+/*
+ *@brief Starts the decoding of an LZ4 frame.
+ *@param Context Pointer to the context to initialize.
+ *@param Output Callback receiving the decoded bytes.
+ *@param History Callback returning earlier decoded bytes.
+ */
+void LZ4_Init(LZ4_Context *Context, LZ4_Output_Callback Output, LZ4_History_Callback History)
+{
+    Context->Output = Output;
+    Context->History = History;
+    Context->Produced = 0;
+    Context->Block_Remaining = 0;
+    Context->Length = 0;
+    Context->Flags = 0;
+    Context->Offset = 0;
+    Context->Token = 0;
+    LZ4_Expect_Field(Context, LZ4_STATE_MAGIC, 4u);
+}
+
+/*
+ *@brief Feeds one byte of the LZ4 frame.
+ *@param Context Pointer to the context.
+ *@param Data The next frame byte.
+ *@returns LZ4_BUSY, LZ4_DONE once the frame is complete, or LZ4_ERROR.
+ */
+LZ4_Status LZ4_Decode_Byte(LZ4_Context *Context, uint8_t Data)
+{
+    LZ4_Status status = LZ4_BUSY;
+
+    if (LZ4_STATE_RAW <= Context->State && LZ4_STATE_MATCH_LENGTH >= Context->State)
+    {
+        if (0u != Context->Block_Remaining)
+        {
+            Context->Block_Remaining--; /* Byte of the current block */
+        }
+        else
+        {
+            Context->State = LZ4_STATE_ERROR; /* Sequence cut by the end of its block */
+        }
+    }
+    else
+    {
+        /* Frame level byte */
+    }
+
+    /* Little-endian fields are assembled from the top, a full field ends up in the low bytes */
+    Context->Value = (Context->Value >> 8) | ((uint32_t)Data << 24);
+
+    switch (Context->State)
+    {
+    case LZ4_STATE_MAGIC:
+    {
+        Context->Count--;
+        if (0u == Context->Count)
+        {
+            Context->State = (LZ4_FRAME_MAGIC == Context->Value) ? LZ4_STATE_FLG : LZ4_STATE_ERROR;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        break;
+    }
+    case LZ4_STATE_FLG:
+    {
+        Context->Flags = Data;
+        if (LZ4_FLG_VERSION_01 != (Data & LZ4_FLG_VERSION_MASK) || (Data & LZ4_FLG_DICTIONARY_ID))
+        {
+            Context->State = LZ4_STATE_ERROR;
+        }
+        else
+        {
+            Context->State = LZ4_STATE_BD;
+        }
+        break;
+    }
+    case LZ4_STATE_BD:
+    {
+        /* The block maximum size does not matter, blocks are not buffered; skip the content size and header checksum */
+        LZ4_Expect_Field(Context, LZ4_STATE_SKIP, (Context->Flags & LZ4_FLG_CONTENT_SIZE) ? 9u : 1u);
+        break;
+    }
+    case LZ4_STATE_SKIP:
+    {
+        Context->Count--;
+        if (0u == Context->Count)
+        {
+            LZ4_Expect_Field(Context, LZ4_STATE_BLOCK_SIZE, 4u);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        break;
+    }
+    case LZ4_STATE_BLOCK_SIZE:
+    {
+        Context->Count--;
+        if (0u != Context->Count)
+        {
+            /* Do nothing */
+        }
+        else if (0u == Context->Value)
+        {
+            /* End mark */
+            if (Context->Flags & LZ4_FLG_CONTENT_CHECKSUM)
+            {
+                LZ4_Expect_Field(Context, LZ4_STATE_CONTENT_CHECKSUM, 4u);
+            }
+            else
+            {
+                Context->State = LZ4_STATE_DONE;
+            }
+        }
+        else
+        {
+            Context->Block_Remaining = Context->Value & ~LZ4_BLOCK_UNCOMPRESSED;
+            Context->State = (Context->Value & LZ4_BLOCK_UNCOMPRESSED) ? LZ4_STATE_RAW : LZ4_STATE_TOKEN;
+        }
+        break;
+    }
+    case LZ4_STATE_RAW:
+    {
+        Context->Output(Data);
+        Context->Produced++;
+        if (0u == Context->Block_Remaining)
+        {
+            LZ4_End_Block(Context);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        break;
+    }
+    case LZ4_STATE_TOKEN:
+    {
+        Context->Token = Data;
+        Context->Length = Data >> 4;
+        if (LZ4_LENGTH_EXTENDED == Context->Length)
+        {
+            Context->State = LZ4_STATE_LITERAL_LENGTH;
+        }
+        else
+        {
+            LZ4_Start_Literals(Context);
+        }
+        break;
+    }
+    case LZ4_STATE_LITERAL_LENGTH:
+    {
+        Context->Length += Data;
+        if (LZ4_LENGTH_BYTE_CONTINUES != Data)
+        {
+            LZ4_Start_Literals(Context);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        break;
+    }
+    case LZ4_STATE_LITERALS:
+    {
+        Context->Output(Data);
+        Context->Produced++;
+        Context->Length--;
+        if (0u == Context->Length)
+        {
+            LZ4_End_Literals(Context);
+        }
+        else if (0u == Context->Block_Remaining)
+        {
+            Context->State = LZ4_STATE_ERROR; /* Literals cut by the end of the block */
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        break;
+    }
+    case LZ4_STATE_OFFSET:
+    {
+        Context->Count--;
+        if (0u == Context->Count)
+        {
+            Context->Offset = (uint16_t)(Context->Value >> 16); /* Both bytes in the top half word */
+            Context->Length = (Context->Token & 0x0Fu) + LZ4_MIN_MATCH;
+            if (LZ4_LENGTH_EXTENDED + LZ4_MIN_MATCH == Context->Length)
+            {
+                Context->State = LZ4_STATE_MATCH_LENGTH;
+            }
+            else
+            {
+                LZ4_Copy_Match(Context);
+            }
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        break;
+    }
+    case LZ4_STATE_MATCH_LENGTH:
+    {
+        Context->Length += Data;
+        if (LZ4_LENGTH_BYTE_CONTINUES != Data)
+        {
+            LZ4_Copy_Match(Context);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        break;
+    }
+    case LZ4_STATE_CONTENT_CHECKSUM:
+    {
+        Context->Count--;
+        if (0u == Context->Count)
+        {
+            Context->State = LZ4_STATE_DONE;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        break;
+    }
+    default:
+    {
+        /* Done or failed: trailing bytes are an error */
+        Context->State = LZ4_STATE_ERROR;
+        break;
+    }
+    }
+
+    if (LZ4_STATE_DONE == Context->State)
+    {
+        status = LZ4_DONE;
+    }
+    else if (LZ4_STATE_ERROR == Context->State)
+    {
+        status = LZ4_ERROR;
+    }
+    else
+    {
+        /* More input expected */
+    }
+
+    return status;
+}
+
+/* EOF */
@@ -0,0 +1,279 @@
+/**
+ * @file PATCH.c
+ * @brief Delta patch decoder.
+ * @details This file contains the decoder of the delta patches described in PATCH.h. A copy is expanded as soon as
+ *          its length is known and inserted bytes are output as they arrive, so the decoder holds no data itself.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "PATCH.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define PATCH_VARINT_CONTINUES 0x80u /* LEB128: more groups follow */
+#define PATCH_VARINT_GROUP 0x7Fu     /* LEB128: 7 value bits per byte */
+#define PATCH_VARINT_MAX_SHIFT 28u   /* Last group of a 32-bit value */
+
+/*
+ *@brief Decoder states.
+ */
+enum
+{
+    PATCH_STATE_MAGIC,         /* Magic number */
+    PATCH_STATE_COMMAND,       /* Command byte */
+    PATCH_STATE_COPY_OFFSET,   /* Old offset of a copy */
+    PATCH_STATE_COPY_LENGTH,   /* Length of a copy */
+    PATCH_STATE_INSERT_LENGTH, /* Length of an insert */
+    PATCH_STATE_INSERT_DATA,   /* Inserted bytes */
+    PATCH_STATE_DONE,          /* Patch complete */
+    PATCH_STATE_ERROR,         /* Decoding failed */
+};
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief Expects a new field in the given state.
+ *@param Context Pointer to the context.
+ *@param State The state collecting the field.
+ */
+static void PATCH_Expect_Field(PATCH_Context *Context, uint8_t State);
+
+/*
+ *@brief Adds one LEB128 group to the field being assembled.
+ *@param Context Pointer to the context.
+ *@param Data The patch byte.
+ *@returns 1 if the field is complete; 0 if more groups follow.
+ */
+static uint8_t PATCH_Varint_Byte(PATCH_Context *Context, uint8_t Data);
+
+/*
+ *@brief Expands a copy of Length old bytes and expects the next command.
+ *@param Context Pointer to the context.
+ *@param Length Number of bytes to copy.
+ */
+static void PATCH_Copy(PATCH_Context *Context, uint32_t Length);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *@brief Expects a new field in the given state.
+ *@param Context Pointer to the context.
+ *@param State The state collecting the field.
+ */
+static void PATCH_Expect_Field(PATCH_Context *Context, uint8_t State)
+{
+    Context->State = State;
+    Context->Value = 0;
+    Context->Shift = 0;
+}
+
+/*
+ *@brief Adds one LEB128 group to the field being assembled.
+ *@param Context Pointer to the context.
+ *@param Data The patch byte.
+ *@returns 1 if the field is complete; 0 if more groups follow.
+ */
+static uint8_t PATCH_Varint_Byte(PATCH_Context *Context, uint8_t Data)
+{
+    uint8_t complete = 0;
+
+    Context->Value |= (uint32_t)(Data & PATCH_VARINT_GROUP) << Context->Shift;
+    if (0u == (Data & PATCH_VARINT_CONTINUES))
+    {
+        complete = 1;
+    }
+    else if (PATCH_VARINT_MAX_SHIFT <= Context->Shift)
+    {
+        Context->State = PATCH_STATE_ERROR; /* Longer than 32 bits */
+    }
+    else
+    {
+        Context->Shift += 7u;
+    }
+
+    return complete;
+}
+
+/*
+ *@brief Expands a copy of Length old bytes and expects the next command.
+ *@param Context Pointer to the context.
+ *@param Length Number of bytes to copy.
+ */
+static void PATCH_Copy(PATCH_Context *Context, uint32_t Length)
+{
+    if (Context->Old_Offset > Context->Old_Length || Context->Old_Length - Context->Old_Offset < Length)
+    {
+        Context->State = PATCH_STATE_ERROR; /* Copy outside the old image */
+    }
+    else
+    {
+        while (0u != Length)
+        {
+            Context->Output(Context->Read_Old(Context->Old_Offset));
+            Context->Old_Offset++;
+            Length--;
+        }
+        Context->State = PATCH_STATE_COMMAND;
+    }
+}
+
+/*
+ *@brief Starts the decoding of a patch.
+ *@param Context Pointer to the context to initialize.
+ *@param Output Callback receiving the new image bytes.
+ *@param Read_Old Callback returning old image bytes.
+ *@param Old_Length Length of the old image.
+ */
+void PATCH_Init(PATCH_Context *Context, PATCH_Output_Callback Output, PATCH_Read_Old_Callback Read_Old,
+                uint32_t Old_Length)
+{
+    Context->Output = Output;
+    Context->Read_Old = Read_Old;
+    Context->Old_Length = Old_Length;
+    Context->Old_Offset = 0;
+    PATCH_Expect_Field(Context, PATCH_STATE_MAGIC);
+}
+
+/*
+ *@brief Feeds one byte of the patch.
+ *@param Context Pointer to the context.
+ *@param Data The next patch byte.
+ *@returns PATCH_BUSY, PATCH_DONE once the patch is complete, or PATCH_ERROR.
+ */
+PATCH_Status PATCH_Decode_Byte(PATCH_Context *Context, uint8_t Data)
+{
+    PATCH_Status status = PATCH_BUSY;
+
+    switch (Context->State)
+    {
+    case PATCH_STATE_MAGIC:
+    {
+        Context->Value |= (uint32_t)Data << Context->Shift;
+        Context->Shift += 8u;
+        if (32u == Context->Shift)
+        {
+            if (PATCH_MAGIC == Context->Value)
+            {
+                Context->State = PATCH_STATE_COMMAND;
+            }
+            else
+            {
+                Context->State = PATCH_STATE_ERROR;
+            }
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        break;
+    }
+    case PATCH_STATE_COMMAND:
+    {
+        if (PATCH_OP_COPY == Data)
+        {
+            PATCH_Expect_Field(Context, PATCH_STATE_COPY_OFFSET);
+        }
+        else if (PATCH_OP_INSERT == Data)
+        {
+            PATCH_Expect_Field(Context, PATCH_STATE_INSERT_LENGTH);
+        }
+        else if (PATCH_OP_END == Data)
+        {
+            Context->State = PATCH_STATE_DONE;
+        }
+        else
+        {
+            Context->State = PATCH_STATE_ERROR;
+        }
+        break;
+    }
+    case PATCH_STATE_COPY_OFFSET:
+    {
+        if (PATCH_Varint_Byte(Context, Data))
+        {
+            Context->Old_Offset = Context->Value;
+            PATCH_Expect_Field(Context, PATCH_STATE_COPY_LENGTH);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        break;
+    }
+    case PATCH_STATE_COPY_LENGTH:
+    {
+        if (PATCH_Varint_Byte(Context, Data))
+        {
+            PATCH_Copy(Context, Context->Value);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        break;
+    }
+    case PATCH_STATE_INSERT_LENGTH:
+    {
+        if (PATCH_Varint_Byte(Context, Data))
+        {
+            Context->State = (0u != Context->Value) ? PATCH_STATE_INSERT_DATA : PATCH_STATE_COMMAND;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        break;
+    }
+    case PATCH_STATE_INSERT_DATA:
+    {
+        Context->Output(Data);
+        Context->Value--;
+        if (0u == Context->Value)
+        {
+            Context->State = PATCH_STATE_COMMAND;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        break;
+    }
+    default:
+    {
+        /* Done or failed: trailing bytes are an error */
+        Context->State = PATCH_STATE_ERROR;
+        break;
+    }
+    }
+
+    if (PATCH_STATE_DONE == Context->State)
+    {
+        status = PATCH_DONE;
+    }
+    else if (PATCH_STATE_ERROR == Context->State)
+    {
+        status = PATCH_ERROR;
+    }
+    else
+    {
+        /* More input expected */
+    }
+
+    return status;
+}
+
+/* EOF */
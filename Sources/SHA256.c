@@ -0,0 +1,217 @@
+/**
+ * @file SHA256.c
+ * @brief SHA-256 engine.
+ * @details This file contains a streaming SHA-256 (FIPS 180-4). The message schedule is kept as a rolling 16-word
+ *          window to save RAM, and the rounds are not unrolled to keep the code small on the Cortex-M0+.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "SHA256.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SHA256_ROTR(x, n) (((x) >> (n)) | ((x) << (32u - (n))))
+#define SHA256_CH(x, y, z) (((x) & (y)) ^ (~(x) & (z)))
+#define SHA256_MAJ(x, y, z) (((x) & (y)) ^ ((x) & (z)) ^ ((y) & (z)))
+#define SHA256_SIGMA0(x) (SHA256_ROTR(x, 2u) ^ SHA256_ROTR(x, 13u) ^ SHA256_ROTR(x, 22u))
+#define SHA256_SIGMA1(x) (SHA256_ROTR(x, 6u) ^ SHA256_ROTR(x, 11u) ^ SHA256_ROTR(x, 25u))
+#define SHA256_GAMMA0(x) (SHA256_ROTR(x, 7u) ^ SHA256_ROTR(x, 18u) ^ ((x) >> 3))
+#define SHA256_GAMMA1(x) (SHA256_ROTR(x, 17u) ^ SHA256_ROTR(x, 19u) ^ ((x) >> 10))
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/*
+ *@brief SHA-256 round constants.
+ */
+static const uint32_t SHA256_K[64] = {
+    0x428A2F98u, 0x71374491u, 0xB5C0FBCFu, 0xE9B5DBA5u, 0x3956C25Bu, 0x59F111F1u, 0x923F82A4u, 0xAB1C5ED5u,
+    0xD807AA98u, 0x12835B01u, 0x243185BEu, 0x550C7DC3u, 0x72BE5D74u, 0x80DEB1FEu, 0x9BDC06A7u, 0xC19BF174u,
+    0xE49B69C1u, 0xEFBE4786u, 0x0FC19DC6u, 0x240CA1CCu, 0x2DE92C6Fu, 0x4A7484AAu, 0x5CB0A9DCu, 0x76F988DAu,
+    0x983E5152u, 0xA831C66Du, 0xB00327C8u, 0xBF597FC7u, 0xC6E00BF3u, 0xD5A79147u, 0x06CA6351u, 0x14292967u,
+    0x27B70A85u, 0x2E1B2138u, 0x4D2C6DFCu, 0x53380D13u, 0x650A7354u, 0x766A0ABBu, 0x81C2C92Eu, 0x92722C85u,
+    0xA2BFE8A1u, 0xA81A664Bu, 0xC24B8B70u, 0xC76C51A3u, 0xD192E819u, 0xD6990624u, 0xF40E3585u, 0x106AA070u,
+    0x19A4C116u, 0x1E376C08u, 0x2748774Cu, 0x34B0BCB5u, 0x391C0CB3u, 0x4ED8AA4Au, 0x5B9CCA4Fu, 0x682E6FF3u,
+    0x748F82EEu, 0x78A5636Fu, 0x84C87814u, 0x8CC70208u, 0x90BEFFFAu, 0xA4506CEBu, 0xBEF9A3F7u, 0xC67178F2u};
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief Compresses one full block into the intermediate hash value.
+ *@param Context Pointer to the context.
+ *@param Block Pointer to SHA256_BLOCK_SIZE bytes.
+ */
+static void SHA256_Compress(SHA256_Context *Context, const uint8_t *Block);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *@brief Compresses one full block into the intermediate hash value.
+ *@param Context Pointer to the context.
+ *@param Block Pointer to SHA256_BLOCK_SIZE bytes.
+ */
+static void SHA256_Compress(SHA256_Context *Context, const uint8_t *Block)
+{
+    uint32_t w[16];
+    uint32_t a = Context->State[0];
+    uint32_t b = Context->State[1];
+    uint32_t c = Context->State[2];
+    uint32_t d = Context->State[3];
+    uint32_t e = Context->State[4];
+    uint32_t f = Context->State[5];
+    uint32_t g = Context->State[6];
+    uint32_t h = Context->State[7];
+    uint32_t t1 = 0;
+    uint32_t t2 = 0;
+    uint8_t i = 0;
+
+    for (i = 0; i < 16u; i++)
+    {
+        w[i] = ((uint32_t)Block[4u * i] << 24) | ((uint32_t)Block[4u * i + 1u] << 16) |
+               ((uint32_t)Block[4u * i + 2u] << 8) | (uint32_t)Block[4u * i + 3u];
+    }
+
+    for (i = 0; i < 64u; i++)
+    {
+        if (16u <= i)
+        {
+            /* Rolling schedule: w[i & 15] holds W[i - 16] and becomes W[i] */
+            w[i & 15u] += SHA256_GAMMA1(w[(i - 2u) & 15u]) + w[(i - 7u) & 15u] + SHA256_GAMMA0(w[(i - 15u) & 15u]);
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        t1 = h + SHA256_SIGMA1(e) + SHA256_CH(e, f, g) + SHA256_K[i] + w[i & 15u];
+        t2 = SHA256_SIGMA0(a) + SHA256_MAJ(a, b, c);
+        h = g;
+        g = f;
+        f = e;
+        e = d + t1;
+        d = c;
+        c = b;
+        b = a;
+        a = t1 + t2;
+    }
+
+    Context->State[0] += a;
+    Context->State[1] += b;
+    Context->State[2] += c;
+    Context->State[3] += d;
+    Context->State[4] += e;
+    Context->State[5] += f;
+    Context->State[6] += g;
+    Context->State[7] += h;
+}
+
+/*
+ *@brief Starts a SHA-256 computation.
+ *@param Context Pointer to the context to initialize.
+ */
+void SHA256_Init(SHA256_Context *Context)
+{
+    Context->State[0] = 0x6A09E667u;
+    Context->State[1] = 0xBB67AE85u;
+    Context->State[2] = 0x3C6EF372u;
+    Context->State[3] = 0xA54FF53Au;
+    Context->State[4] = 0x510E527Fu;
+    Context->State[5] = 0x9B05688Cu;
+    Context->State[6] = 0x1F83D9ABu;
+    Context->State[7] = 0x5BE0CD19u;
+    Context->Length = 0;
+    Context->Block_Used = 0;
+}
+
+/*
+ *@brief Feeds data into a SHA-256 computation.
+ *@param Context Pointer to the context.
+ *@param Data Pointer to the data, in RAM or memory-mapped flash.
+ *@param Length Number of bytes.
+ */
+void SHA256_Update(SHA256_Context *Context, const uint8_t *Data, uint32_t Length)
+{
+    Context->Length += Length;
+
+    while (0 != Length)
+    {
+        if (0 == Context->Block_Used && SHA256_BLOCK_SIZE <= Length)
+        {
+            SHA256_Compress(Context, Data); /* Whole blocks are compressed in place */
+            Data += SHA256_BLOCK_SIZE;
+            Length -= SHA256_BLOCK_SIZE;
+        }
+        else
+        {
+            Context->Block[Context->Block_Used++] = *Data++;
+            Length--;
+            if (SHA256_BLOCK_SIZE == Context->Block_Used)
+            {
+                SHA256_Compress(Context, Context->Block);
+                Context->Block_Used = 0;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+    }
+}
+
+/*
+ *@brief Finishes a SHA-256 computation.
+ *@param Context Pointer to the context; it must be initialized again before reuse.
+ *@param Digest Buffer receiving the SHA256_DIGEST_SIZE byte digest.
+ */
+void SHA256_Final(SHA256_Context *Context, uint8_t *Digest)
+{
+    uint32_t bit_length_high = Context->Length >> 29;
+    uint32_t bit_length_low = Context->Length << 3;
+    uint8_t i = 0;
+
+    /* Padding: 0x80, zeros, then the 64-bit big-endian message length in bits */
+    Context->Block[Context->Block_Used++] = 0x80u;
+    if (SHA256_BLOCK_SIZE - 8u < Context->Block_Used)
+    {
+        while (SHA256_BLOCK_SIZE > Context->Block_Used)
+        {
+            Context->Block[Context->Block_Used++] = 0;
+        }
+        SHA256_Compress(Context, Context->Block);
+        Context->Block_Used = 0;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    while (SHA256_BLOCK_SIZE - 8u > Context->Block_Used)
+    {
+        Context->Block[Context->Block_Used++] = 0;
+    }
+    for (i = 0; i < 4u; i++)
+    {
+        Context->Block[56u + i] = (uint8_t)(bit_length_high >> (24u - 8u * i));
+        Context->Block[60u + i] = (uint8_t)(bit_length_low >> (24u - 8u * i));
+    }
+    SHA256_Compress(Context, Context->Block);
+
+    for (i = 0; i < 8u; i++)
+    {
+        Digest[4u * i] = (uint8_t)(Context->State[i] >> 24);
+        Digest[4u * i + 1u] = (uint8_t)(Context->State[i] >> 16);
+        Digest[4u * i + 2u] = (uint8_t)(Context->State[i] >> 8);
+        Digest[4u * i + 3u] = (uint8_t)Context->State[i];
+    }
+}
+/* EOF */
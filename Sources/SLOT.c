@@ -0,0 +1,372 @@
+/**
+ * @file SLOT.c
+ * @brief Application slot selection.
+ * @details This file contains the functions that read and append the slot metadata log. Every change of the selection,
+ *          including a rollback, is one word programmed into an erased word, so it is atomic and costs no erase
+ *          cycle. When the log is full, it is restarted with the current state in the other metadata sector.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "SLOT.h"
+#include "FLASH.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SLOT_UNUSED 0xFFFFFFFFu     /* Erased log word */
+#define SLOT_NO_LOG 0u              /* No valid metadata sector */
+#define SLOT_WORD_TAG_MASK 0xFFFFFF00u /* Tag part of SLOT_WORD_TRIAL and SLOT_WORD_SELECT */
+
+/*
+ *@brief State given by the log words replayed so far.
+ */
+typedef struct SLOT_State
+{
+    uint8_t Selected;  /**< Slot selected by the log */
+    uint8_t On_Trial;  /**< 1 while the selected slot waits for SLOT_WORD_CONFIRM */
+    uint32_t Attempts; /**< Boots of the slot on trial */
+    uint32_t Used;     /**< Log words programmed, also the index of the next one */
+    uint32_t Address;  /**< Metadata sector of the log, SLOT_NO_LOG if there is none */
+    uint32_t Sequence; /**< Sequence of the log */
+} SLOT_State;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static SLOT_State SLOT_Log; /* State of the log in flash */
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief Updates a state with one log word.
+ *@param State Pointer to the state.
+ *@param Word The log word.
+ */
+static void SLOT_Apply(SLOT_State *State, uint32_t Word);
+
+/*
+ *@brief Replays the log words of a metadata sector.
+ *@param State Pointer to the state to fill.
+ *@param Address Address of the metadata sector.
+ */
+static void SLOT_Replay(SLOT_State *State, uint32_t Address);
+
+/*
+ *@brief Replays the current log in flash.
+ *@param State Pointer to the state to fill.
+ */
+static void SLOT_Read(SLOT_State *State);
+
+/*
+ *@brief Programs the next log word and applies it. Interrupts must be disabled by the caller.
+ *@param Word The log word.
+ */
+static void SLOT_Program(uint32_t Word);
+
+/*
+ *@brief Starts a new log holding the current state in the other metadata sector. Interrupts must be disabled by the caller.
+ *@returns 1 if the new log is the current one, 0 if it did not read back and the old log was kept.
+ */
+static uint8_t SLOT_Restart(void);
+
+/*
+ *@brief Appends a word to the log, restarting the log first if it is full. Interrupts must be disabled by the caller.
+ *@param Word The log word.
+ */
+static void SLOT_Append(uint32_t Word);
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *@brief Updates a state with one log word.
+ *@param State Pointer to the state.
+ *@param Word The log word.
+ */
+static void SLOT_Apply(SLOT_State *State, uint32_t Word)
+{
+    if (SLOT_WORD_TRIAL == (Word & SLOT_WORD_TAG_MASK) && SLOT_B >= (Word & ~SLOT_WORD_TAG_MASK))
+    {
+        State->Selected = (uint8_t)(Word & ~SLOT_WORD_TAG_MASK);
+        State->On_Trial = 1;
+        State->Attempts = 0;
+    }
+    else if (SLOT_WORD_SELECT == (Word & SLOT_WORD_TAG_MASK) && SLOT_B >= (Word & ~SLOT_WORD_TAG_MASK))
+    {
+        State->Selected = (uint8_t)(Word & ~SLOT_WORD_TAG_MASK);
+        State->On_Trial = 0;
+    }
+    else if (SLOT_WORD_ATTEMPT == Word)
+    {
+        State->Attempts++;
+    }
+    else if (SLOT_WORD_CONFIRM == Word)
+    {
+        State->On_Trial = 0;
+    }
+    else
+    {
+        /* Unknown word, ignored */
+    }
+}
+
+/*
+ *@brief Replays the log words of a metadata sector.
+ *@param State Pointer to the state to fill.
+ *@param Address Address of the metadata sector.
+ */
+static void SLOT_Replay(SLOT_State *State, uint32_t Address)
+{
+    const volatile SLOT_Metadata *log = (const volatile SLOT_Metadata *)Address;
+
+    State->Selected = SLOT_A;
+    State->On_Trial = 0;
+    State->Attempts = 0;
+    State->Used = 0;
+    State->Address = Address;
+    State->Sequence = log->Sequence;
+    while (SLOT_WORDS > State->Used && SLOT_UNUSED != log->Words[State->Used])
+    {
+        SLOT_Apply(State, log->Words[State->Used]);
+        State->Used++;
+    }
+}
+
+/*
+ *@brief Replays the current log in flash.
+ *@details The current log is the valid one with the highest sequence. Without one, slot A is selected.
+ *@param State Pointer to the state to fill.
+ */
+static void SLOT_Read(SLOT_State *State)
+{
+    const volatile SLOT_Metadata *log = (const volatile SLOT_Metadata *)SLOT_METADATA_ADDRESS;
+    uint32_t current = SLOT_NO_LOG;
+    uint32_t sequence = 0;
+    uint8_t i = 0;
+
+    for (i = 0; i < SLOT_METADATA_SECTORS; i++)
+    {
+        log = (const volatile SLOT_Metadata *)(SLOT_METADATA_ADDRESS + i * IMAGE_SECTOR_SIZE);
+        if (SLOT_METADATA_MAGIC == log->Magic && ~log->Sequence == log->Sequence_Check &&
+            (SLOT_NO_LOG == current || 0 < (int32_t)(log->Sequence - sequence)))
+        {
+            current = (uint32_t)log;
+            sequence = log->Sequence;
+        }
+        else
+        {
+            /* Erased, not verified, or older */
+        }
+    }
+
+    if (SLOT_NO_LOG != current)
+    {
+        SLOT_Replay(State, current);
+    }
+    else
+    {
+        State->Selected = SLOT_A;
+        State->On_Trial = 0;
+        State->Attempts = 0;
+        State->Used = 0;
+        State->Address = SLOT_NO_LOG;
+        State->Sequence = 0;
+    }
+}
+
+/*
+ *@brief Programs the next log word and applies it. Interrupts must be disabled by the caller.
+ *@param Word The log word.
+ */
+static void SLOT_Program(uint32_t Word)
+{
+    const volatile SLOT_Metadata *log = (const volatile SLOT_Metadata *)SLOT_Log.Address;
+
+    Program_LongWord((uint32_t)&log->Words[SLOT_Log.Used], Word);
+    SLOT_Log.Used++;
+    SLOT_Apply(&SLOT_Log, Word);
+}
+
+/*
+ *@brief Starts a new log holding the current state in the other metadata sector. Interrupts must be disabled by the caller.
+ *@details The old log stays the current one until the new one read back and got its magic, and is erased only then.
+ *@returns 1 if the new log is the current one, 0 if it did not read back and the old log was kept.
+ */
+static uint8_t SLOT_Restart(void)
+{
+    SLOT_State check;
+    uint32_t old = SLOT_Log.Address;
+    uint32_t address = SLOT_METADATA_ADDRESS;
+    uint32_t attempts = SLOT_Log.Attempts;
+    uint8_t restarted = 0;
+
+    if (SLOT_METADATA_ADDRESS == old)
+    {
+        address += IMAGE_SECTOR_SIZE;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    Erase_Sector(address);
+    SLOT_Log.Address = address;
+    SLOT_Log.Sequence++;
+    SLOT_Log.Used = 0;
+    Program_LongWord((uint32_t)&((const volatile SLOT_Metadata *)address)->Sequence, SLOT_Log.Sequence);
+    Program_LongWord((uint32_t)&((const volatile SLOT_Metadata *)address)->Sequence_Check, ~SLOT_Log.Sequence);
+    if (SLOT_Log.On_Trial)
+    {
+        SLOT_Program(SLOT_WORD_TRIAL | SLOT_Log.Selected);
+        while (0 != attempts)
+        {
+            SLOT_Program(SLOT_WORD_ATTEMPT);
+            attempts--;
+        }
+    }
+    else
+    {
+        SLOT_Program(SLOT_WORD_SELECT | SLOT_Log.Selected);
+    }
+
+    SLOT_Replay(&check, address);
+    if (check.Selected == SLOT_Log.Selected && check.On_Trial == SLOT_Log.On_Trial &&
+        check.Attempts == SLOT_Log.Attempts && check.Used == SLOT_Log.Used &&
+        ~check.Sequence == ((const volatile SLOT_Metadata *)address)->Sequence_Check)
+    {
+        Program_LongWord((uint32_t)&((const volatile SLOT_Metadata *)address)->Magic, SLOT_METADATA_MAGIC);
+        if (SLOT_NO_LOG != old)
+        {
+            Erase_Sector(old);
+        }
+        else
+        {
+            /* First log */
+        }
+        restarted = 1;
+    }
+    else
+    {
+        SLOT_Read(&SLOT_Log); /* The new log is not valid, the old one is still the current one */
+    }
+
+    return restarted;
+}
+
+/*
+ *@brief Appends a word to the log, restarting the log first if it is full. Interrupts must be disabled by the caller.
+ *@details The last word of the log is kept erased, so a slot on trial can always be confirmed by the application.
+ *         The word is dropped if the log is full and could not be restarted.
+ *@param Word The log word.
+ */
+static void SLOT_Append(uint32_t Word)
+{
+    uint8_t ready = 1;
+
+    if (SLOT_NO_LOG == SLOT_Log.Address || SLOT_WORDS <= SLOT_Log.Used + 1u)
+    {
+        ready = SLOT_Restart();
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    if (ready)
+    {
+        SLOT_Program(Word);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/*
+ *@brief Returns the slot selected by the metadata.
+ *@returns SLOT_A or SLOT_B.
+ */
+uint8_t SLOT_Active(void)
+{
+    SLOT_Read(&SLOT_Log);
+
+    return SLOT_Log.Selected;
+}
+
+/*
+ *@brief Returns the selected slot if the application there confirmed it.
+ *@returns SLOT_A or SLOT_B, or SLOT_NONE while a slot is on trial.
+ */
+uint8_t SLOT_Confirmed(void)
+{
+    SLOT_State state; /* On the stack, static data is not initialized yet */
+    uint8_t slot = SLOT_NONE;
+
+    SLOT_Read(&state);
+    if (!state.On_Trial)
+    {
+        slot = state.Selected;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    return slot;
+}
+
+/*
+ *@brief Chooses the slot to boot and records the boot attempt.
+ *@returns SLOT_A or SLOT_B.
+ */
+uint8_t SLOT_Boot(void)
+{
+    SLOT_Read(&SLOT_Log);
+    if (SLOT_Log.On_Trial && SLOT_BOOT_ATTEMPTS <= SLOT_Log.Attempts)
+    {
+        SLOT_Select(SLOT_OTHER(SLOT_Log.Selected)); /* Never confirmed: roll back */
+    }
+    else if (SLOT_Log.On_Trial)
+    {
+        __disable_irq();
+        SLOT_Append(SLOT_WORD_ATTEMPT);
+        __enable_irq();
+    }
+    else
+    {
+        /* Confirmed selection */
+    }
+
+    return SLOT_Log.Selected;
+}
+
+/*
+ *@brief Selects a slot for good.
+ *@param Slot SLOT_A or SLOT_B.
+ */
+void SLOT_Select(uint8_t Slot)
+{
+    SLOT_Read(&SLOT_Log);
+    __disable_irq();
+    SLOT_Append(SLOT_WORD_SELECT | Slot);
+    __enable_irq();
+}
+
+/*
+ *@brief Puts a slot on trial.
+ *@param Slot SLOT_A or SLOT_B.
+ */
+void SLOT_Activate(uint8_t Slot)
+{
+    SLOT_Read(&SLOT_Log);
+    SLOT_Append(SLOT_WORD_TRIAL | Slot);
+}
+
+/* EOF */
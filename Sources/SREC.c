@@ -133,6 +133,39 @@ uint8_t Check_Line_Record(volatile char *srec_line)
     return result;
 }
 
+/*
+ *@brief Returns the number of address bytes of an SREC record.
+ *@param record Pointer to the SREC record.
+ *@returns 3 for S2 and S8 records, 4 for S3 and S7 records, 2 otherwise.
+ */
+uint8_t record_address_size(volatile char *record)
+{
+    uint8_t size = 2;
+
+    switch (record[1])
+    {
+    case '2':
+    case '8':
+    {
+        size = 3; /* 24-bit address */
+        break;
+    }
+    case '3':
+    case '7':
+    {
+        size = 4; /* 32-bit address */
+        break;
+    }
+    default:
+    {
+        size = 2; /* 16-bit address */
+        break;
+    }
+    }
+
+    return size;
+}
+
 /*
  *@brief Parses an SREC record and fills the Record structure.
  *@param record Pointer to the SREC record.
@@ -144,13 +177,18 @@ void record_parser(volatile char *record, Record *record_struct, uint8_t byteCou
     uint8_t byteCount_of_data;
     uint32_t address = 0;
     uint8_t i = 0;
+    uint8_t address_size = record_address_size(record);
+    uint8_t start = 4 + 2 * address_size; /* First data character */
 
     /* Extract the address from the record */
-    record_struct->address = (hexCharToByte(record[4]) << 12) | (hexCharToByte(record[5]) << 8) |
-                             (hexCharToByte(record[6]) << 4) | hexCharToByte(record[7]);
+    for (i = 0; i < 2 * address_size; i++)
+    {
+        address = (address << 4) | hexCharToByte(record[4 + i]);
+    }
+    record_struct->address = address;
 
     /* Calculate the byte count of data */
-    byteCount_of_data = byteCount_in_record * 2 - 6;
+    byteCount_of_data = byteCount_in_record * 2 - 2 * address_size - 2;
 
     /* Parse the data from the record */
     for (i = 0; i < byteCount_of_data; i += 4)
@@ -158,34 +196,34 @@ void record_parser(volatile char *record, Record *record_struct, uint8_t byteCou
         if (0 == i)
         {
             /* Fill data1 array with bytes from the record */
-            record_struct->data1[0] = hex_chars_to_byte(record[8], record[9]);
-            record_struct->data1[1] = hex_chars_to_byte(record[10], record[11]);
-            record_struct->data1[2] = hex_chars_to_byte(record[12], record[13]);
-            record_struct->data1[3] = hex_chars_to_byte(record[14], record[15]);
+            record_struct->data1[0] = hex_chars_to_byte(record[start], record[start + 1]);
+            record_struct->data1[1] = hex_chars_to_byte(record[start + 2], record[start + 3]);
+            record_struct->data1[2] = hex_chars_to_byte(record[start + 4], record[start + 5]);
+            record_struct->data1[3] = hex_chars_to_byte(record[start + 6], record[start + 7]);
         }
         else if (4 == i)
         {
             /* Fill data2 array with bytes from the record */
-            record_struct->data2[0] = hex_chars_to_byte(record[16], record[17]);
-            record_struct->data2[1] = hex_chars_to_byte(record[18], record[19]);
-            record_struct->data2[2] = hex_chars_to_byte(record[20], record[21]);
-            record_struct->data2[3] = hex_chars_to_byte(record[22], record[23]);
+            record_struct->data2[0] = hex_chars_to_byte(record[start + 8], record[start + 9]);
+            record_struct->data2[1] = hex_chars_to_byte(record[start + 10], record[start + 11]);
+            record_struct->data2[2] = hex_chars_to_byte(record[start + 12], record[start + 13]);
+            record_struct->data2[3] = hex_chars_to_byte(record[start + 14], record[start + 15]);
         }
         else if (8 == i)
         {
             /* Fill data3 array with bytes from the record */
-            record_struct->data3[0] = hex_chars_to_byte(record[24], record[25]);
-            record_struct->data3[1] = hex_chars_to_byte(record[26], record[27]);
-            record_struct->data3[2] = hex_chars_to_byte(record[28], record[29]);
-            record_struct->data3[3] = hex_chars_to_byte(record[30], record[31]);
+            record_struct->data3[0] = hex_chars_to_byte(record[start + 16], record[start + 17]);
+            record_struct->data3[1] = hex_chars_to_byte(record[start + 18], record[start + 19]);
+            record_struct->data3[2] = hex_chars_to_byte(record[start + 20], record[start + 21]);
+            record_struct->data3[3] = hex_chars_to_byte(record[start + 22], record[start + 23]);
         }
         else if (12 == i)
         {
             /* Fill data4 array with bytes from the record */
-            record_struct->data4[0] = hex_chars_to_byte(record[32], record[33]);
-            record_struct->data4[1] = hex_chars_to_byte(record[34], record[35]);
-            record_struct->data4[2] = hex_chars_to_byte(record[36], record[37]);
-            record_struct->data4[3] = hex_chars_to_byte(record[38], record[39]);
+            record_struct->data4[0] = hex_chars_to_byte(record[start + 24], record[start + 25]);
+            record_struct->data4[1] = hex_chars_to_byte(record[start + 26], record[start + 27]);
+            record_struct->data4[2] = hex_chars_to_byte(record[start + 28], record[start + 29]);
+            record_struct->data4[3] = hex_chars_to_byte(record[start + 30], record[start + 31]);
         }
         else
         {
@@ -193,3 +231,27 @@ void record_parser(volatile char *record, Record *record_struct, uint8_t byteCou
         }
     }
 }
+
+/*
+ *@brief Decodes the whole data field of an SREC record.
+ *@details Unlike record_parser, the number of data bytes is not limited to 16, so records carrying more than
+ *         16 bytes, such as the image digest record, can be decoded.
+ *@param record Pointer to the SREC record.
+ *@param data Buffer receiving the data bytes, at least byteCount_in_record - 3 bytes long (S1 records).
+ *@param byteCount_in_record The byte count in the record.
+ *@returns The number of data bytes decoded.
+ */
+uint8_t record_data_parser(volatile char *record, uint8_t *data, uint8_t byteCount_in_record)
+{
+    uint8_t address_size = record_address_size(record);
+    uint8_t byteCount_of_data = byteCount_in_record - address_size - 1; /* Address bytes + 1 checksum byte */
+    uint8_t start = 4 + 2 * address_size;                               /* Data starts after 'S', type, count and address */
+    uint8_t i = 0;
+
+    for (i = 0; i < byteCount_of_data; i++)
+    {
+        data[i] = hex_chars_to_byte(record[start + 2 * i], record[start + 1 + 2 * i]);
+    }
+
+    return byteCount_of_data;
+}
@@ -0,0 +1,104 @@
+/**
+ * @file TIMESTAMP.c
+ * @brief Boot timestamps.
+ * @details This file contains the functions that time the boot milestones with SysTick. All the state lives in the
+ *          table in m_noinit, as TIMESTAMP_Start runs before .data and .bss are initialized.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "TIMESTAMP.h"
+#include "../Includes/DRIVER/DRIVER_MCG.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *@brief Starts SysTick and a new table.
+ *@details Called first thing by Reset_Handler, before SystemInit and the C runtime init: it only uses the stack and
+ *         m_noinit. A valid table left by the previous boot is copied to TIMESTAMP_PREVIOUS_ADDRESS.
+ */
+void TIMESTAMP_Start(void)
+{
+    volatile TIMESTAMP_Table *table = (volatile TIMESTAMP_Table *)TIMESTAMP_ADDRESS;
+    volatile TIMESTAMP_Table *previous = (volatile TIMESTAMP_Table *)TIMESTAMP_PREVIOUS_ADDRESS;
+    uint8_t i = 0; /* For the loop */
+
+    SysTick->LOAD = SysTick_LOAD_RELOAD_Msk; /* Free-running over the whole 24-bit range */
+    SysTick->VAL = 0;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk | SysTick_CTRL_ENABLE_Msk;
+
+    if (TIMESTAMP_MAGIC == table->Magic)
+    {
+        previous->Clock_Hz = table->Clock_Hz;
+        for (i = 0; i < TIMESTAMP_COUNT; i++)
+        {
+            previous->Ticks[i] = table->Ticks[i];
+        }
+        previous->Magic = TIMESTAMP_MAGIC;
+    }
+    else
+    {
+        previous->Magic = 0; /* Power-up, RAM contents are random */
+    }
+
+    table->Magic = TIMESTAMP_MAGIC;
+    table->Clock_Hz = MCG_FLL_CLOCK_DEFAULT_HZ;
+    table->Now = 0;
+    table->Last = 0; /* VAL as written above */
+    for (i = 0; i < TIMESTAMP_COUNT; i++)
+    {
+        table->Ticks[i] = TIMESTAMP_NONE;
+    }
+}
+
+/*
+ *@brief Returns the ticks since the entry of Reset_Handler.
+ *@returns The ticks of the core clock after reset.
+ */
+uint32_t TIMESTAMP_Now(void)
+{
+    volatile TIMESTAMP_Table *table = (volatile TIMESTAMP_Table *)TIMESTAMP_ADDRESS;
+    uint32_t value = SysTick->VAL;
+
+    table->Now += (table->Last - value) & SysTick_LOAD_RELOAD_Msk; /* SysTick counts down, wrapping at 2^24 */
+    table->Last = value;
+
+    return table->Now;
+}
+
+/*
+ *@brief Records the time of a milestone.
+ *@param Milestone TIMESTAMP_MAIN to TIMESTAMP_UPDATE_MODE.
+ */
+void TIMESTAMP_Record(uint8_t Milestone)
+{
+    volatile TIMESTAMP_Table *table = (volatile TIMESTAMP_Table *)TIMESTAMP_ADDRESS;
+
+    if (TIMESTAMP_COUNT > Milestone)
+    {
+        table->Ticks[Milestone] = TIMESTAMP_Now();
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/* EOF */
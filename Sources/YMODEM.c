@@ -0,0 +1,186 @@
+/**
+ * @file YMODEM.c
+ * @brief XMODEM-1K / YMODEM block receiver.
+ * @details This file contains a byte-at-a-time receiver for XMODEM-1K and YMODEM blocks. The block is collected into the
+ *          context, and its CRC is checked once the last byte arrives, so the caller sees only complete, intact blocks.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include "YMODEM.h"
+#include "CRC16.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+
+/*
+ *@brief Receiver states.
+ */
+enum
+{
+    YMODEM_STATE_START,      /* Waiting for a block start, YMODEM_EOT or YMODEM_CAN */
+    YMODEM_STATE_NUMBER,     /* Block number */
+    YMODEM_STATE_COMPLEMENT, /* Complement of the block number */
+    YMODEM_STATE_DATA,       /* Data bytes */
+    YMODEM_STATE_CRC_HIGH,   /* CRC high byte */
+    YMODEM_STATE_CRC_LOW,    /* CRC low byte */
+};
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *@brief Prepares the receiver for the start of a block.
+ *@param Context Pointer to the context to initialize.
+ */
+void YMODEM_Init(YMODEM_Context *Context)
+{
+    Context->Length = 0;
+    Context->Index = 0;
+    Context->CRC = 0;
+    Context->Number = 0;
+    Context->State = YMODEM_STATE_START;
+}
+
+/*
+ *@brief Feeds one received byte.
+ *@param Context Pointer to the context.
+ *@param Data The received byte.
+ *@returns YMODEM_BUSY, YMODEM_BLOCK, YMODEM_END, YMODEM_CANCEL or YMODEM_ERROR.
+ */
+YMODEM_Status YMODEM_Receive_Byte(YMODEM_Context *Context, uint8_t Data)
+{
+    YMODEM_Status status = YMODEM_BUSY;
+
+    switch (Context->State)
+    {
+    case YMODEM_STATE_START:
+    {
+        if (YMODEM_SOH == Data || YMODEM_STX == Data)
+        {
+            Context->Length = (YMODEM_STX == Data) ? YMODEM_BLOCK_1K_SIZE : YMODEM_BLOCK_SIZE;
+            Context->Index = 0;
+            Context->State = YMODEM_STATE_NUMBER;
+        }
+        else if (YMODEM_EOT == Data)
+        {
+            status = YMODEM_END;
+        }
+        else if (YMODEM_CAN == Data)
+        {
+            status = YMODEM_CANCEL;
+        }
+        else
+        {
+            /* Noise between blocks */
+        }
+        break;
+    }
+    case YMODEM_STATE_NUMBER:
+    {
+        Context->Number = Data;
+        Context->State = YMODEM_STATE_COMPLEMENT;
+        break;
+    }
+    case YMODEM_STATE_COMPLEMENT:
+    {
+        if (0xFFu == (uint32_t)Context->Number + Data) /* Data is the complement of the block number */
+        {
+            Context->State = YMODEM_STATE_DATA;
+        }
+        else
+        {
+            Context->State = YMODEM_STATE_START;
+            status = YMODEM_ERROR;
+        }
+        break;
+    }
+    case YMODEM_STATE_DATA:
+    {
+        Context->Data[Context->Index++] = Data;
+        if (Context->Length == Context->Index)
+        {
+            Context->State = YMODEM_STATE_CRC_HIGH;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        break;
+    }
+    case YMODEM_STATE_CRC_HIGH:
+    {
+        Context->CRC = (uint16_t)Data << 8;
+        Context->State = YMODEM_STATE_CRC_LOW;
+        break;
+    }
+    case YMODEM_STATE_CRC_LOW:
+    {
+        Context->CRC |= Data;
+        Context->State = YMODEM_STATE_START;
+        if (Context->CRC == CRC16_Update(CRC16_XMODEM_INITIAL_VALUE, Context->Data, Context->Length))
+        {
+            status = YMODEM_BLOCK;
+        }
+        else
+        {
+            status = YMODEM_ERROR;
+        }
+        break;
+    }
+    default:
+    {
+        Context->State = YMODEM_STATE_START;
+        break;
+    }
+    }
+
+    return status;
+}
+
+/*
+ *@brief Reads the file size from a YMODEM block 0.
+ *@param Context Pointer to the context holding block 0.
+ *@returns The file size, or YMODEM_SIZE_UNKNOWN if the block carries none.
+ */
+uint32_t YMODEM_File_Size(const YMODEM_Context *Context)
+{
+    uint32_t size = YMODEM_SIZE_UNKNOWN;
+    uint16_t i = 0;
+
+    while (i < Context->Length && '\0' != Context->Data[i])
+    {
+        i++; /* Skip the file name */
+    }
+    i++;
+    if (i < Context->Length && '0' <= Context->Data[i] && '9' >= Context->Data[i])
+    {
+        size = 0;
+        while (i < Context->Length && '0' <= Context->Data[i] && '9' >= Context->Data[i])
+        {
+            size = size * 10u + (Context->Data[i] - '0');
+            i++;
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    return size;
+}
+
+/* EOF */
@@ -21,10 +21,19 @@
 #include "../Includes/DRIVER/DRIVER_GPIO.h"
 #include "../Includes/DRIVER/DRIVER_UART.h"
 #include "../Includes/DRIVER/DRIVER_NVIC.h"
+#include "../Includes/DRIVER/DRIVER_MCG.h"
 #include "SREC.h"
+#include "FRAME.h"
 #include "FLASH.h"
 #include "BOOT.h"
+#include "IMAGE.h"
+#include "JOURNAL.h"
+#include "SLOT.h"
+#include "LZ4.h"
+#include "PATCH.h"
+#include "YMODEM.h"
 #include "QUEUE.h"
+#include "TIMESTAMP.h"
 
 /*******************************************************************************
  * Definitions
@@ -32,18 +41,94 @@
 #define PIN_RED_LED 29
 #define PIN_GREEN_LED 5
 #define PIN_SWITCH_2 12
-#define APPLICATION_ADDRESS 0x0000A000
+#define PIN_UART0_RX 1
+#define PIN_UART0_TX 2
 #define NUMBER_OF_SECTORS_TO_DELETE 50
 #define NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME 4
 #define SMALLEST_BYTES_COUNT_NUMBER 3 /* If a line record does not contain data, there are 2 address bytes + 1 checksum byte = 3 bytes*/
+#define UART0_CLOCK_HZ MCG_FLL_CLOCK_DEFAULT_HZ /* MCGFLLCLK after reset */
+#define UART0_BAUD_RATE 115200u     /* UART0 baud rate */
+#define UART0_OVERSAMPLING 16u      /* Oversampling ratio = OSR + 1, OSR = 15 after reset */
+#define UART0_SBR DRIVER_UART_SBR(UART0_CLOCK_HZ, UART0_BAUD_RATE, UART0_OVERSAMPLING) /* SBR = 20971520 / (115200 * 16) = 11 */
+#define SYNC_PATTERN "SYNC"         /* Sent by the host during the boot window to stay in bootloader mode */
+#define SYNC_ACK 0x06u              /* Reply to SYNC_PATTERN, the host stops repeating it */
+#define SYNC_QUIET_MS 10u           /* Silence on UART0 that ends the SYNC_PATTERN repeats */
+#define SWITCH_2_SETTLE_TICKS (MCG_FLL_CLOCK_DEFAULT_HZ / 10000u) /* 100 us for the pull-up to charge SW2, at the core clock after reset */
+#define STREAM_BUFFER_SIZE 16384u   /* Raw bytes buffered between the UART0 interrupt and the decoder */
+#define SESSION_UNKNOWN 0u          /* No byte received yet */
+#define SESSION_SREC 1u             /* S-record lines */
+#define SESSION_FRAME 2u            /* Binary frames, selected by FRAME_HANDSHAKE */
+#define SESSION_YMODEM 3u           /* XMODEM-1K or YMODEM transfer, selected by YMODEM_SOH or YMODEM_STX */
+#define YMODEM_PHASE_START 0u       /* Waiting for YMODEM block 0 or XMODEM-1K block 1 */
+#define YMODEM_PHASE_DATA 1u        /* Data blocks of the file */
+#define YMODEM_PHASE_CLOSE 2u       /* YMODEM file ended, an empty block 0 ends the batch */
+#define YMODEM_PHASE_DONE 3u        /* Transfer over */
+#define YMODEM_BLOCK_NONE 0u        /* No block being handed over */
+#define YMODEM_BLOCK_HANDING 1u     /* Block data going into queue elements */
+#define YMODEM_BLOCK_HANDED 2u      /* Block data in queue elements, acknowledged once they are processed */
+#define YMODEM_PAYLOAD_NONE 0u      /* No data block received yet */
+#define YMODEM_PAYLOAD_SREC 1u      /* The file is an S-record file */
+#define YMODEM_PAYLOAD_BINARY 2u    /* The file is a binary image loaded at the start of the slot being updated */
+#define YMODEM_POLL_WRAPS 3u        /* SysTick wraps between two YMODEM_CRC_REQUEST, about 1 s at 48 MHz (free-running since reset) */
+#define STREAM_FORMAT_NONE 0u       /* Line records only */
+#define STREAM_FORMAT_LZ4 1u        /* Raw bytes are an LZ4 frame of the image */
+#define STREAM_FORMAT_PATCH 2u      /* Raw bytes are a delta patch against the installed image */
+#if FRAME_WINDOW >= NUMBER_OF_QUEUES
+#error "The queue must hold a whole window of frames plus the one being received"
+#endif
+#define STREAM_BUSY 0u              /* More raw bytes expected */
+#define STREAM_DONE 1u              /* Whole image programmed */
+#define STREAM_ERROR 2u             /* Corrupted stream, buffer overflow or image outside the slot */
 
 /*******************************************************************************
  * Variables
  ******************************************************************************/
 static volatile uint8_t buffer_index = 0;      /* Index for the current position in index of the queue. */
-static volatile char received_data;            /* Variable to store the received UART data. */
+static volatile uint8_t received_data;         /* Variable to store the received UART data. */
 static volatile Queue queue[NUMBER_OF_QUEUES]; /* Variable to store line records. */
 static volatile uint8_t index_empty = 0;       /* Variable to store empty queue index. */
+static volatile uint32_t line_count = 0;       /* S-record lines received, numbers the next one */
+static volatile uint8_t session_format = SESSION_UNKNOWN; /* Selected by the first byte of the session */
+static uint32_t update_address = APPLICATION_ADDRESS;      /* Slot being updated, the inactive one */
+static uint8_t frame_expected = 0;                         /* Sequence number of the next frame to process */
+static uint8_t ymodem_phase = YMODEM_PHASE_START;          /* Progress of the transfer */
+#if BOOT_FEATURE_YMODEM
+static YMODEM_Context ymodem;                              /* Block receiver of an XMODEM-1K or YMODEM transfer */
+static uint8_t ymodem_batch = 0;                           /* Transfer started with a YMODEM block 0 */
+static uint8_t ymodem_block = YMODEM_BLOCK_NONE;           /* Hand-over of the current block */
+static uint8_t ymodem_payload = YMODEM_PAYLOAD_NONE;       /* Contents of the file, told by its first bytes */
+static uint8_t ymodem_next = 1;                            /* Number of the next data block */
+static uint8_t ymodem_polls = 0;                           /* SysTick wraps since the last YMODEM_CRC_REQUEST */
+static uint8_t ymodem_element = NUMBER_OF_QUEUES;          /* Queue element collecting the current line, none if NUMBER_OF_QUEUES */
+static uint8_t ymodem_line = 0;                            /* Characters of the current line */
+static uint16_t ymodem_offset = 0;                         /* Data bytes of the current block handed over */
+static uint32_t ymodem_remaining = YMODEM_SIZE_UNKNOWN;    /* File bytes still expected */
+static uint32_t ymodem_address = APPLICATION_ADDRESS;      /* Flash address of the next byte of a binary file */
+static char ymodem_end_record[MAX_LINE_LENGTH_RECORD];     /* End line of the file, processed once the transfer is over */
+#endif
+#if BOOT_FEATURE_STREAM
+static volatile uint8_t stream_buffer[STREAM_BUFFER_SIZE]; /* Raw bytes of a compressed image or a patch, or YMODEM blocks */
+static volatile uint16_t stream_head = 0;                  /* Next free position, written by the UART0 interrupt */
+static volatile uint16_t stream_tail = 0;                  /* Next byte to decode, written by the main loop */
+static volatile uint32_t stream_remaining = 0;             /* Raw bytes still expected; line records while 0 */
+static volatile uint8_t stream_overflow = 0;               /* A raw byte arrived while the buffer was full */
+#endif
+static uint8_t stream_format = STREAM_FORMAT_NONE;         /* Decoder of the raw bytes */
+static uint32_t patch_base = 0;                            /* Address of the base image in the active slot, 0 if not patching */
+#if (BOOT_FEATURE_LZ4 || BOOT_FEATURE_PATCH)
+static uint8_t stream_status = STREAM_BUSY;                /* Decoder result so far */
+static uint32_t stream_offset = 0;                         /* Raw bytes decoded, selects the key stream */
+static uint32_t output_address = APPLICATION_ADDRESS;      /* Flash address of the next decoded byte */
+static uint32_t output_limit = APPLICATION_ADDRESS;        /* End of the region the image may use */
+static uint8_t output_error = 0;                           /* Decoded data went past the slot */
+static uint8_t output_word[NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME]; /* Decoded bytes not programmed yet */
+#endif
+#if BOOT_FEATURE_LZ4
+static LZ4_Context decompressor;                           /* Decoder of a compressed image */
+#endif
+#if BOOT_FEATURE_PATCH
+static PATCH_Context patcher;                              /* Decoder of a delta patch */
+#endif
 /*******************************************************************************
  * Prototypes
  ******************************************************************************/
@@ -59,55 +144,47 @@ static volatile uint8_t index_empty = 0;       /* Variable to store empty queue
  */
 void Initialize_Clock_and_Pin_UART0(void)
 {
-    SIM_Config SIM_UART0_SOPT2_Config = {
-        .Declare_SIM_Register = SOPT2_UART0SRC,               /* Selects the clock source for the UART0 as MCGFLLCLK clock */
-        .Initialize_SOPT2.UART0SRC = SOPT2_UART0SRC_FLL_PLL}; /* Sets the UART0 clock source to MCGFLLCLK clock */
+    SIM_Config SIM_UART0_Config = {
+        .Initialize_SOPT2.UART0SRC = SOPT2_UART0SRC_FLL_PLL, /* Sets the UART0 clock source to MCGFLLCLK clock */
+        .Initialize_SCGC5.PORT_A = CLOCK_STATE_ENABLE,       /* Port A Clock Gate Control enabled */
+        .Initialize_SCGC4.UART_0 = CLOCK_STATE_ENABLE};      /* UART0 Clock Gate Control enabled */
 
-    SIM_Config SIM_UART0_SCGC5_Config = {
-        .Declare_SIM_Register = SCGC5_PORTA,            /* Selects the clock for Port A */
-        .Initialize_SCGC5.PORT_A = CLOCK_STATE_ENABLE}; /* Port A Clock Gate Control enabled */
+    PORT_Batch_Config PORT_UART0_Pins_Config = {
+        .PORTx = (PORT_Type *)PORTA,                             /* Port A base address for UART0 TX and RX */
+        .Pin_Mask = (1u << PIN_UART0_TX) | (1u << PIN_UART0_RX), /* Pin 2 for UART0 TX, pin 1 for UART0 RX */
+        .PCR.MUX = PCR_IRQC_MUX_ALT2};                           /* Set both pins to UART0 functionality (ALT2) */
 
-    SIM_Config SIM_UART0_SCGC4_Config = {
-        .Declare_SIM_Register = SCGC4_UART_0,           /* Selects the clock for UART0 */
-        .Initialize_SCGC4.UART_0 = CLOCK_STATE_ENABLE}; /* UART0 Clock Gate Control enabled */
-
-    PORT_Config PORT_UART0_Pin_tx_Config = {
-        .PORTx = (PORT_Type *)PORTA,   /* Port A base address for UART0 TX */
-        .Pin = 2,                      /* Pin 2 for UART0 TX */
-        .PCR.MUX = PCR_IRQC_MUX_ALT2}; /* Set pin 2 to UART0 TX functionality (ALT2) */
-
-    PORT_Config PORT_UART0_Pin_rx_Config = {
-        .PORTx = (PORT_Type *)PORTA,   /* Port A base address for UART0 RX */
-        .Pin = 1,                      /* Pin 1 for UART0 RX */
-        .PCR.MUX = PCR_IRQC_MUX_ALT2}; /* Set pin 1 to UART0 RX functionality (ALT2) */
-
-    DRIVER_SIM_Config(&SIM_UART0_SOPT2_Config);    /* Configure UART0 clock source */
-    DRIVER_SIM_Config(&SIM_UART0_SCGC5_Config);    /* Enable the clock for Port A */
-    DRIVER_PORT_Config(&PORT_UART0_Pin_tx_Config); /* Configure pin 2 for UART0 TX */
-    DRIVER_PORT_Config(&PORT_UART0_Pin_rx_Config); /* Configure pin 1 for UART0 RX */
-    DRIVER_SIM_Config(&SIM_UART0_SCGC4_Config);    /* Enable the clock for UART0 */
+    DRIVER_SIM_Config_Batch(&SIM_UART0_Config);        /* Select the UART0 clock source, enable Port A and UART0 clocks */
+    DRIVER_PORT_Config_Batch(&PORT_UART0_Pins_Config); /* Configure pins 1 and 2 for UART0 with one GPCLR write */
 }
 
 /*
  *@brief Initializes UART0 with specified settings.
  *@details Configures UART0 with a baud rate, enables the transmitter and receiver, and initializes the UART0 module.
- *         The configuration includes setting up the baud rate divisor, enabling the UART transmitter and receiver,
- *         and configuring the UART control registers.
+ *         The register images are computed at compile time and each register is written once.
  *@param None
  *@returns None
  */
 void Initialize_UART0(void)
 {
-    UART_Config UART0_Config = {
-        .UARTx = (UART_Type *)UART0, /* Base address of the UART0 module */
-        .BDL = 0xB,                  /* Baud Rate Divisor LSB (Low Byte) | SBR =  UART clock / (Baud rate * (OSROSR = 17 after reset) )*/
-                                     /* SBR = 20971520 /(115200 * 17) = 11 = 0xB  */
-        .BDH.SBR = 0x0,              /* Baud Rate Divisor MSB (High Byte) */
-        .C2.TE = C2_TE_ENABLED,      /* Enable UART Transmitter */
-        .C2.RIE = C2_RIE_ENABLED,    /* Receiver interrupt enabled */
-        .C2.RE = C2_RE_ENABLED};     /* Enable UART Receiver */
+    static const UART_Image UART0_Image = {
+        .BDH = DRIVER_UART_BDH_IMAGE(UART0_SBR, BDH_SBNS_ONE),                   /* Baud Rate Divisor MSB, one stop bit */
+        .BDL = DRIVER_UART_BDL_IMAGE(UART0_SBR),                                 /* Baud Rate Divisor LSB */
+        .C2 = DRIVER_UART_C2_IMAGE(C2_TE_ENABLED, C2_RE_ENABLED, C2_RIE_ENABLED)}; /* Enable transmitter, receiver and receiver interrupt */
+
+    DRIVER_UART_Config_Image((UART_Type *)UART0, &UART0_Image); /* Apply the UART0 configuration */
+}
 
-    DRIVER_UART_Config(&UART0_Config); /* Apply the UART0 configuration */
+/*
+ *@brief Switches the clock profile and recomputes the UART0 divisor for the new MCGFLLCLK.
+ *@details Must be called while UART0 is idle, i.e. after send_bytes() returned and before the host starts sending.
+ *@param Profile The clock profile to switch to.
+ *@returns None
+ */
+void Set_Clock_Profile(MCG_Clock_Profile Profile)
+{
+    DRIVER_MCG_Set_Clock_Profile(Profile);
+    DRIVER_UART_Set_Baud_Rate((UART_Type *)UART0, DRIVER_MCG_Get_FLL_Clock(), UART0_BAUD_RATE, UART0_OVERSAMPLING);
 }
 
 /*
@@ -215,6 +292,121 @@ void Initialize_Switch_2(void)
     DRIVER_GPIO_Config(&GPIO_Switch_2_Config); /* Initialize the SWITCH pin as intput */
 }
 
+/*
+ *@brief Returns the peripherals configured by the bootloader to their reset state.
+ *@details Restores UART0, the UART0, LED and switch pins, the LED pin directions, the clock profile, and the SIM
+ *         clock gates and clock sources, so the application starts from the same state as after a reset and
+ *         does not have to re-initialize them defensively.
+ *@param None
+ *@returns None
+ */
+void Deinitialize_Peripherals(void)
+{
+    static const UART_Image UART0_Reset_Image = {
+        .BDH = 0x00,  /* BDH reset value */
+        .BDL = 0x04,  /* BDL reset value */
+        .C2 = 0x00}; /* C2 reset value, transmitter, receiver and interrupt disabled */
+
+    SIM_Config SIM_Reset_Config = {
+        .Initialize_SOPT2.UART0SRC = SOPT2_UART0SRC_FLL_PLL, /* UART0 clock source back to disabled */
+        .Initialize_SCGC4.UART_0 = CLOCK_STATE_ENABLE,       /* UART0 clock gate back to disabled */
+        .Initialize_SCGC5.PORT_A = CLOCK_STATE_ENABLE,       /* Port A clock gate back to disabled */
+        .Initialize_SCGC5.PORT_C = CLOCK_STATE_ENABLE,       /* Port C clock gate back to disabled */
+        .Initialize_SCGC5.PORT_D = CLOCK_STATE_ENABLE,       /* Port D clock gate back to disabled */
+        .Initialize_SCGC5.PORT_E = CLOCK_STATE_ENABLE};      /* Port E clock gate back to disabled */
+
+    PORT_Batch_Config PORT_Reset_Config[] = {
+        {.PORTx = (PORT_Type *)PORTA, .Pin_Mask = (1u << PIN_UART0_TX) | (1u << PIN_UART0_RX)}, /* UART0 pins */
+        {.PORTx = (PORT_Type *)PORTC, .Pin_Mask = (1u << PIN_SWITCH_2)},                        /* Switch 2 pin */
+        {.PORTx = (PORT_Type *)PORTD, .Pin_Mask = (1u << PIN_GREEN_LED)},                       /* Green LED pin */
+        {.PORTx = (PORT_Type *)PORTE, .Pin_Mask = (1u << PIN_RED_LED)}};                        /* Red LED pin */
+
+    GPIO_Config GPIO_Red_Led_Reset_Config = {
+        .GPIOx = (GPIO_Type *)GPIOE,         /* Base address for GPIO E */
+        .Pin = PIN_RED_LED,                  /* Pin number for the red LED */
+        .PDDR = PDDR_PDD_INPUT,              /* Pin back to input */
+        .Initial_State_of_Output_Pin = LOW}; /* Output data back to 0 */
+
+    GPIO_Config GPIO_Green_Led_Reset_Config = {
+        .GPIOx = (GPIO_Type *)GPIOD,         /* Base address for GPIO D */
+        .Pin = PIN_GREEN_LED,                /* Pin number for the green LED */
+        .PDDR = PDDR_PDD_INPUT,              /* Pin back to input */
+        .Initial_State_of_Output_Pin = LOW}; /* Output data back to 0 */
+
+    uint8_t i = 0; /* For loop */
+
+    DRIVER_UART_Config_Image((UART_Type *)UART0, &UART0_Reset_Image); /* UART0 back to reset values */
+    DRIVER_GPIO_Config(&GPIO_Red_Led_Reset_Config);                   /* Red LED pin back to input, output data 0 */
+    DRIVER_GPIO_Config(&GPIO_Green_Led_Reset_Config);                 /* Green LED pin back to input, output data 0 */
+    for (i = 0; i < sizeof(PORT_Reset_Config) / sizeof(PORT_Reset_Config[0]); i++)
+    {
+        DRIVER_PORT_Config_Batch(&PORT_Reset_Config[i]); /* PCR back to 0 (pin disabled, no pull) */
+    }
+    DRIVER_MCG_Set_Clock_Profile(MCG_CLOCK_PROFILE_DEFAULT); /* The application expects the reset default clocks */
+    DRIVER_SIM_Reset_Batch(&SIM_Reset_Config);               /* Clock gates and UART0 clock source back to reset values */
+}
+
+/*
+ *@brief Starts the application before the C runtime init when nothing keeps the device in the bootloader.
+ *@details Called by Reset_Handler right after SystemInit, with interrupts masked and .data and .bss not initialized,
+ *         so it only uses the stack and functions without static data. It returns, and the normal boot in main()
+ *         takes over, on an update request, a non-zero sync window, a slot on trial, SW2 pressed or an image
+ *         that does not check out. Only SW2 is configured, and put back to its reset state before the jump; it
+ *         is read once its pull-up has charged the pin. Interrupts stay masked until the jump. With the
+ *         configuration word erased the sync window is BOOT_SYNC_WINDOW_DEFAULT_MS, so this path is only taken
+ *         once the window is programmed to 0. TIMESTAMP_JUMP is the only milestone recorded on this path.
+ *@param None
+ *@returns None
+ */
+void Boot_Fast_Path(void)
+{
+    SIM_Config SIM_Switch_2_Reset_Config = {
+        .Initialize_SCGC5.PORT_C = CLOCK_STATE_ENABLE}; /* Port C clock gate back to disabled */
+
+    PORT_Batch_Config PORT_Switch_2_Reset_Config = {
+        .PORTx = (PORT_Type *)PORTC,         /* Base address for PORT C */
+        .Pin_Mask = (1u << PIN_SWITCH_2)};   /* PCR back to 0 (pin disabled, no pull) */
+
+    uint8_t slot = SLOT_NONE;             /* Confirmed slot */
+    GPIO_PIN_STATE switch_2 = LOW;        /* SW2 level, LOW while pressed */
+    uint32_t start = 0;                   /* Ticks when the SW2 pull-up was enabled */
+
+    if (BOOT_UPDATE_REQUEST_MAGIC != *(volatile uint32_t *)BOOT_UPDATE_REQUEST_ADDRESS && 0 == Boot_Sync_Window())
+    {
+        slot = SLOT_Confirmed();
+    }
+    else
+    {
+        /* Left to main(), which reads the request or listens for the sync pattern */
+    }
+
+    if (SLOT_NONE != slot)
+    {
+        Initialize_Switch_2();
+        start = TIMESTAMP_Now();
+        while (SWITCH_2_SETTLE_TICKS > TIMESTAMP_Now() - start)
+        {
+            /* The pin reads LOW until the pull-up has charged it */
+        }
+        switch_2 = DRIVER_GPIO_PDIR_Read_Input_Pin(GPIOC, PIN_SWITCH_2);
+        DRIVER_PORT_Config_Batch(&PORT_Switch_2_Reset_Config);
+        DRIVER_SIM_Reset_Batch(&SIM_Switch_2_Reset_Config);
+        if (HIGH == switch_2 && IMAGE_VALID == Check_Application_Image(IMAGE_SLOT_ADDRESS(slot)))
+        {
+            TIMESTAMP_Record(TIMESTAMP_JUMP);
+            JumpToApplication(IMAGE_SLOT_ADDRESS(slot));
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
 /*
  *@brief Sends a single byte of data via UART0.
  *@details Writes a byte of data to the UART0 transmit data buffer and waits until the transmission is complete.
@@ -242,7 +434,7 @@ void send_bytes(char data)
  */
 void send_string(char *string)
 {
-    while ('\0' != *string)
+    while ('\0' != *string && (SESSION_YMODEM != session_format || YMODEM_PHASE_DONE == ymodem_phase)) /* The sender reads the replies */
     {
         send_bytes(*string); /* Send the current character */
         string++;            /* Move to the next character in the string */
@@ -250,183 +442,1393 @@ void send_string(char *string)
 }
 
 /*
- * @brief  UART0 Interrupt Handler
- * @details  Handles the UART0 interrupt triggered when the Receive Data Register Full (RDRF) flag is set.
- *           Reads the received data, processes commands terminated by newline characters, and manages the command queue.
- * @param  None
- * @returns  None
+ *@brief Listens on UART0 for SYNC_PATTERN during the boot window.
+ *@details UART0 is polled, its interrupt is not enabled yet. The window is timed with TIMESTAMP_Now().
+ *         Once the pattern is received it is answered with SYNC_ACK, and the repeats still in flight are read
+ *         until the line stays quiet for SYNC_QUIET_MS, so none of them starts the update session.
+ *@param Window_Ms Length of the window in ms, 0 to return at once.
+ *@returns 1 if SYNC_PATTERN was received; 0 otherwise.
  */
-void Implement_UART_0_IRQHandler(void)
+uint8_t Wait_For_Sync(uint32_t Window_Ms)
 {
-    if (S1_RDRF_FULL == DRIVER_UART_S1_Receive_Data_Register_Full_Flag((UART_Type *)UART0))
-    {
-        received_data = DRIVER_UART_D_Read_receive_data_buffer((UART_Type *)UART0); /* Read and return the received character */
+    static const char pattern[] = SYNC_PATTERN;
+    uint32_t ticks_per_ms = DRIVER_MCG_Get_FLL_Clock() / 1000u; /* Core clock runs at MCGFLLCLK */
+    uint32_t start = TIMESTAMP_Now(); /* Start of the window, then of the silence once synchronized */
+    uint8_t matched = 0;              /* Pattern characters received in a row */
+    char data;                        /* Received character */
 
-        if (received_data == '\n') /* Check if the received data is a newline character (indicating end of command). */
-        {
-            queue[index_empty].record[buffer_index] = '\0'; /* Null-terminate the command string. */
-            queue[index_empty].state = 1;                   /* Enables the state of having data at the element */
-            index_empty = find_queue_empty(queue);          /* Find empty queue to save next data*/
-            buffer_index = 0;                               /* Reset the buffer index for the next command. */
-        }
-        else
+    while ((sizeof(pattern) - 1u > matched) ? (Window_Ms * ticks_per_ms > TIMESTAMP_Now() - start)
+                                            : (SYNC_QUIET_MS * ticks_per_ms > TIMESTAMP_Now() - start))
+    {
+        if (DRIVER_UART_S1_Receive_Data_Register_Full_Flag((UART_Type *)UART0))
         {
-            queue[index_empty].record[buffer_index++] = received_data; /* Save data to queue */
-            if (MAX_LINE_LENGTH_RECORD - 1 <= buffer_index)            /* Check if the buffer index exceeds the buffer length (to avoid overflow). */
+            data = DRIVER_UART_D_Read_receive_data_buffer((UART_Type *)UART0);
+            if (sizeof(pattern) - 1u <= matched)
+            {
+                start = TIMESTAMP_Now(); /* Repeats still arriving */
+            }
+            else if (pattern[matched] == data)
             {
-                buffer_index = 0; /* Reset the buffer index to handle the next command. */
+                matched++;
+                if (sizeof(pattern) - 1u == matched)
+                {
+                    send_bytes(SYNC_ACK);
+                    start = TIMESTAMP_Now();
+                }
+                else
+                {
+                    /* Do nothing */
+                }
             }
             else
             {
-                /* Do nothing */
+                matched = (pattern[0] == data) ? 1u : 0u;
             }
         }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+
+    return (sizeof(pattern) - 1u == matched) ? 1u : 0u;
+}
+
+/*
+ *@brief Sends a 32-bit value as 8 hexadecimal characters via UART0.
+ *@param Value The value to be transmitted, most significant digit first.
+ *@returns None
+ */
+void send_hex_word(uint32_t Value)
+{
+    static const char digits[] = "0123456789ABCDEF";
+    int8_t shift = 0;
+
+    for (shift = 28; shift >= 0; shift -= 4)
+    {
+        send_bytes(digits[(Value >> shift) & 0xFu]);
+    }
+}
+
+/*
+ *@brief Sends the boot timestamps of this boot and of the previous one via UART0.
+ *@details One line per milestone, in hexadecimal SysTick ticks since the entry of Reset_Handler. FFFFFFFF marks a
+ *         milestone not reached; the previous boot is left out after a power-up.
+ *@param None
+ *@returns None
+ */
+void Send_Timestamps(void)
+{
+    static char *const names[TIMESTAMP_COUNT] = {
+        " main entered        ", " peripherals ready   ", " boot mode read      ",
+        " image checked       ", " jump to application ", " update mode entered "};
+    const volatile TIMESTAMP_Table *table = (const volatile TIMESTAMP_Table *)TIMESTAMP_ADDRESS;
+    const volatile TIMESTAMP_Table *previous = (const volatile TIMESTAMP_Table *)TIMESTAMP_PREVIOUS_ADDRESS;
+    uint8_t i = 0; /* For the loop */
+
+    send_string(" Boot timestamps, SysTick ticks at 0x");
+    send_hex_word(table->Clock_Hz);
+    send_string(" Hz\r\n");
+    send_string(" milestone            this boot previous boot\r\n");
+    for (i = 0; i < TIMESTAMP_COUNT; i++)
+    {
+        send_string(names[i]);
+        send_hex_word(table->Ticks[i]);
+        send_string("  ");
+        if (TIMESTAMP_MAGIC == previous->Magic)
+        {
+            send_hex_word(previous->Ticks[i]);
+        }
+        else
+        {
+            send_string("--------");
+        }
+        send_string("\r\n");
+    }
+}
+
+/*
+ *@brief Copies data bytes out of the current record.
+ *@param Destination Pointer to the destination.
+ *@param Source Pointer to the record data.
+ *@param Length Number of bytes.
+ *@returns None
+ */
+void Copy_Record_Data(uint8_t *Destination, const uint8_t *Source, uint8_t Length)
+{
+    uint8_t i = 0;
+
+    for (i = 0; i < Length; i++)
+    {
+        Destination[i] = Source[i];
+    }
+}
+
+/*
+ *@brief Reports a failed update and stops.
+ *@details The image header is not programmed, so the device stays in bootloader mode after the next reset.
+ *@param Reason The reason of the failure.
+ *@returns None
+ */
+void Stop_Update(char *Reason)
+{
+    if (SESSION_YMODEM == session_format && YMODEM_PHASE_DONE != ymodem_phase)
+    {
+        send_bytes(YMODEM_CAN); /* Cancels the transfer in the terminal program */
+        send_bytes(YMODEM_CAN);
+        ymodem_phase = YMODEM_PHASE_DONE;
     }
     else
     {
-        /* Do Nothing */
+        /* Do nothing */
+    }
+    send_string(Reason);
+    send_string("Please start over from the beginning!\r\n");
+    while (1)
+    {
+        /* Do nothing */
     }
 }
 
 /*
- * @brief  Main function for the bootloader application
- * @details  Initializes peripherals, handles UART0 interrupts, and processes incoming commands for bootloading.
- *           It erases sectors, receives SREC file lines, parses them, and programs the flash memory.
- * @param  None
- * @returns  None
+ *@brief Erases the header sector and the sectors the new image will occupy in the slot being updated.
+ *@details Called when the first record of the update arrives, so the erase can be sized from the image header.
+ *         The header sector is erased first, which invalidates the old image of the slot before any of it is
+ *         overwritten; the active slot is left untouched. When an interrupted update of the same image resumes, the
+ *         sectors below Resume_Address are kept and the resume point is reported to the host, which may skip the
+ *         records below it.
+ *@param Resume_Address First address to erase, `update_address` unless the update resumes.
+ *@param Number_Of_Sectors Number of sectors of the image from `update_address`.
+ *@returns The end address of the erased region.
  */
-int main(void)
+uint32_t Prepare_Image_Slot(uint32_t Resume_Address, uint8_t Number_Of_Sectors)
 {
-    uint8_t i = 1;                 /* For loop */
-    uint8_t j = 0;                 /* For loop */
-    uint8_t number_of_4_bytes = 0; /* Number of 4 bytes to write to flash */
-    uint8_t byte_count = 0;        /* Byte count in record line */
-    Record record_struct;          /*  contains information of 1 record line*/
+    send_string(" Formatting data:");
+    Erase_Sector(IMAGE_SLOT_HEADER_ADDRESS(update_address)); /* Invalidate the old image of the slot first */
+    Erase_Multi_Sector(Resume_Address, Number_Of_Sectors - (Resume_Address - update_address) / IMAGE_SECTOR_SIZE);
+    send_string(".....................done!\r\n");
+    if (update_address < Resume_Address)
+    {
+        send_string(" Resume from ");
+        send_hex_word(Resume_Address);
+        send_string("\r\n");
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    send_string(" \n");
+    send_string(" Updating your firmware: ");
 
-    GPIO_PIN_STATE Red_Led_State = LOW;   /* State of the red LED. */
-    GPIO_PIN_STATE Green_Led_State = LOW; /* State of the green LED. */
+    return update_address + Number_Of_Sectors * IMAGE_SECTOR_SIZE;
+}
 
-    Initialize_Clock_and_Pin_UART0(); /* Initialize clock and UART0 pins for communication. */
-    Initialize_UART0();               /* Configure UART0 for receiving and sending data. */
-    Initialize_Red_Led();             /* Initialize the red LED GPIO pin. */
-    Initialize_Green_Led();           /* Initialize the green LED GPIO pin. */
-    Initialize_Switch_2();            /* Initialize the Switch pin. */
+/*
+ *@brief Prepares the slot being updated for a delta patch.
+ *@details Called when the patch record is the first record of the update. The image in the active slot must be the
+ *         base of the patch; it stays there, and the patch copies from it while the new image is written into the
+ *         erased slot being updated.
+ *@param Base_Address Address of the active slot.
+ *@param Base_Length Length of the base image.
+ *@param Base_CRC32 CRC-32 of the base image.
+ *@returns The end address of the region the new image may use.
+ */
+uint32_t Prepare_Patch_Slot(uint32_t Base_Address, uint32_t Base_Length, uint32_t Base_CRC32)
+{
+    if (!IMAGE_Check_Patch_Base(Base_Address, Base_Length, Base_CRC32))
+    {
+        Stop_Update("Patch does not match the installed image\r\n");
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    send_string(" Formatting data:");
+    Erase_Sector(IMAGE_SLOT_HEADER_ADDRESS(update_address)); /* Invalidate the old image of the slot first */
+    Erase_Multi_Sector(update_address, IMAGE_SLOT_SIZE / IMAGE_SECTOR_SIZE);
+    send_string(".....................done!\r\n");
+    send_string(" \n");
+    send_string(" Updating your firmware: ");
+    patch_base = Base_Address;
 
-    DRIVER_NVIC_Enable_External_Interrupt(UART0_IRQn);         /* Enable External Interrupt UART0 */
-    DRIVER_NVIC_UART0_IRQHandler(Implement_UART_0_IRQHandler); /* Callback if interruption occurs */
+    return update_address + IMAGE_SLOT_SIZE;
+}
 
-    while (1) /* Main loop to continuously check for incoming commands and process them. */
+/*
+ *@brief Programs one word into the slot being updated and feeds it to the image digest.
+ *@details Erased words (0xFFFFFFFF) are not programmed, the slot was erased when the update started.
+ *@param Address Flash address of the word.
+ *@param Data Pointer to the 4 bytes, as they end up in flash.
+ *@param Length Number of bytes of the word that belong to the image, 4 except for the end of a compressed image.
+ *@returns None
+ */
+void Program_Image_Word(uint32_t Address, uint8_t *Data, uint8_t Length)
+{
+    if (0xFFu != (Data[0] & Data[1] & Data[2] & Data[3]))
+    {
+        __disable_irq();                    /* Disable all interrupts*/
+        Program_LongWord_8B(Address, Data); /* Program Address and Data (8bit pointer) into Flash Memory */
+        __enable_irq();                     /* Anable all interrupts*/
+    }
+    else
+    {
+        /* Already erased */
+    }
+    IMAGE_Stream_Data(Address, Data, Length); /* Hash while receiving */
+}
+
+/*
+ *@brief Programs one word of a data record into the slot being updated.
+ *@details The word goes through the image pipeline: decryption (encrypted images only), flash programming and the
+ *         streaming digest, which covers the plaintext as it ends up in flash.
+ *@param Address Flash address of the word.
+ *@param Data Pointer to the 4 data bytes; decrypted in place.
+ *@returns None
+ */
+void Program_Record_Word(uint32_t Address, uint8_t *Data)
+{
+    IMAGE_Decrypt(Address, Data, NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME);
+    Program_Image_Word(Address, Data, NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME);
+}
+
+#if (BOOT_FEATURE_LZ4 || BOOT_FEATURE_PATCH)
+/*
+ *@brief Receives one decoded image byte and programs each completed word.
+ *@details A dot is sent for every kilobyte of image, like one per record for S-record files.
+ *@param Data The decoded byte.
+ *@returns None
+ */
+void Stream_Output(uint8_t Data)
+{
+    uint8_t position = output_address % NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME;
+
+    if (output_address < output_limit && 0 == output_error)
     {
-        if (!DRIVER_GPIO_PDIR_Read_Input_Pin(GPIOC, PIN_SWITCH_2))
+        output_word[position] = Data;
+        if (NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME - 1 == position)
         {
-            DRIVER_GPIO_Output_Pin_State(GPIOE, PIN_RED_LED, LOW); /* Turn on the RED LED */
-            send_string(" \n");
-            send_string(" |***************** BOOTLOADER *****************|\r\n");
-            send_string(" Preparing............\r\n");
-            send_string(" Formatting data:");
-            Erase_Multi_Sector(APPLICATION_ADDRESS, NUMBER_OF_SECTORS_TO_DELETE); /* Erase Multi Sector before flash */
-            send_string(".....................done!\r\n");
-            send_string(" \n");
-            send_string(" Please update SREC (file format) now !\r\n");
-            send_string(" Updating your firmware: ");
-            initialize_state(queue); /* Initialize 'state' to 0*/
-            while (1)
-            {
-                for (i = 0; i < NUMBER_OF_QUEUES; i++)
-                {
-                    if (queue[i].state == 1)
-                    {
-                        if (queue[i].record[1] == '1')
-                        {
-                            byte_count = Check_Line_Record(queue[i].record);
-                            if (SMALLEST_BYTES_COUNT_NUMBER <= byte_count)
-                            {
-                                number_of_4_bytes = byte_count / NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME; /* Because each write to flash is 4 bytes */
-                                record_parser(queue[i].record, &record_struct, byte_count);                /* Get data and adress*/
-                                for (j = 0; j < number_of_4_bytes; j++)
-                                {
-                                    if (j == 0)
-                                    {
-                                        __disable_irq();                                                 /* Disable all interrupts*/
-                                        Program_LongWord_8B(record_struct.address, record_struct.data1); /* Program Address and Data (8bit pointer) into Flash Memory */
-                                        __enable_irq();                                                  /* Anable all interrupts*/
-                                    }
-                                    else if (j == 1)
-                                    {
-                                        record_struct.address += 4;
-                                        __disable_irq();
-                                        Program_LongWord_8B(record_struct.address, record_struct.data2);
-                                        __enable_irq();
-                                    }
-                                    else if (j == 2)
-                                    {
-                                        record_struct.address += 4;
-                                        __disable_irq();
-                                        Program_LongWord_8B(record_struct.address, record_struct.data3);
-                                        __enable_irq();
-                                    }
-                                    else if (j == 3)
-                                    {
-                                        record_struct.address += 4;
-                                        __disable_irq();
-                                        Program_LongWord_8B(record_struct.address, record_struct.data4);
-                                        __enable_irq();
-                                    }
-                                    else
-                                    {
-                                        /* Do Nothing */
-                                    }
-                                }
+            Program_Image_Word(output_address - position, output_word, NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME);
+        }
+        else
+        {
+            /* Word not complete yet */
+        }
+        output_address++;
+        if (0 == output_address % IMAGE_SECTOR_SIZE)
+        {
+            send_bytes('.');
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else
+    {
+        output_error = 1;
+    }
+}
 
-                                send_bytes('.');
-                            }
-                            else
-                            {
-                                send_string("Update failed\r\n");
-                                send_string("Please start over from the beginning!\r\n");
-                                queue[i].state = 0; /* Returns empty state ready to receive data */
-                                while (1)
-                                {
-                                    /* Do nothing */
-                                }
-                            }
+/*
+ *@brief Returns a decompressed byte for an LZ4 match copy.
+ *@details The match history is read back from the flash programmed so far, and from the word not programmed yet, so
+ *         the decompressor needs no RAM window.
+ *@param Distance Distance back from the next decompressed byte.
+ *@returns The decompressed byte.
+ */
+uint8_t Stream_History(uint16_t Distance)
+{
+    uint32_t address = output_address - Distance;
+    uint8_t data = 0xFF;
 
-                            queue[i].state = 0;
-                        }
-                        else
-                        {
-                            queue[i].state = 0;
-                        }
+    if (address >= output_address - output_address % NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME)
+    {
+        data = output_word[address % NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME];
+    }
+    else
+    {
+        data = *(const uint8_t *)address;
+    }
 
-                        if (queue[i].record[1] == '9')
-                        {
-                            send_string(".done!\r\n");
-                            send_string("  \n");
-                            send_string("           +++++++++++++++++++++++++++++\n");
-                            send_string("  \n");
-                            send_string(" Please press the Reset Button to run the Application. Thanks :)\r\n");
-                            while (1)
-                            {
-                                /* Do nothing */
-                            }
-                        }
-                        else
-                        {
-                            /* Do nothing */
-                        }
-                    }
+    return data;
+}
+
+/*
+ *@brief Returns a byte of the installed image for a patch copy.
+ *@details The base image stays intact in the active slot at `patch_base` while the patch is applied.
+ *@param Offset Offset in the installed image.
+ *@returns The old byte.
+ */
+uint8_t Stream_Read_Old(uint32_t Offset)
+{
+    return *(const uint8_t *)(patch_base + Offset);
+}
+
+/*
+ *@brief Switches UART0 reception to the raw bytes of a compressed image or a patch.
+ *@details The next Length bytes received are decoded into the image, after decryption if decryption is enabled; line
+ *         records resume after them. Once this returns, the host is told to send them.
+ *@param Format STREAM_FORMAT_LZ4 or STREAM_FORMAT_PATCH.
+ *@param Length Number of raw bytes.
+ *@param Limit End of the region the image may use.
+ *@param Old_Length Length of the installed image, patches only.
+ *@returns None
+ */
+void Stream_Start(uint8_t Format, uint32_t Length, uint32_t Limit, uint32_t Old_Length)
+{
+    if (STREAM_FORMAT_PATCH == Format)
+    {
+#if BOOT_FEATURE_PATCH
+        PATCH_Init(&patcher, Stream_Output, Stream_Read_Old, Old_Length);
+#else
+        (void)Old_Length;
+#endif
+    }
+    else
+    {
+#if BOOT_FEATURE_LZ4
+        LZ4_Init(&decompressor, Stream_Output, Stream_History);
+#endif
+    }
+    stream_format = Format;
+    stream_status = STREAM_BUSY;
+    stream_offset = 0;
+    output_address = update_address;
+    output_limit = Limit;
+    stream_head = 0;
+    stream_tail = 0;
+    stream_remaining = Length; /* From now on the UART0 interrupt fills the stream buffer */
+}
+
+/*
+ *@brief Programs the last partial word of a decoded image, padded with erased bytes.
+ *@param None
+ *@returns None
+ */
+void Stream_Flush(void)
+{
+    uint8_t length = output_address % NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME; /* Image bytes in the last word */
+    uint8_t position = length;
+
+    if (0 != length && 0 == output_error)
+    {
+        while (NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME > position)
+        {
+            output_word[position++] = 0xFF; /* Erased tail of the last word */
+        }
+        Program_Image_Word(output_address - length, output_word, length);
+    }
+    else
+    {
+        /* Image ends on a word boundary */
+    }
+}
+
+/*
+ *@brief Decodes the raw bytes received so far.
+ *@details Each byte is decrypted with the key stream of its offset in the raw stream, then decoded. A patch is
+ *         applied while it is received, like a compressed image: it writes into the slot erased beforehand.
+ *@param None
+ *@returns STREAM_BUSY, STREAM_DONE once the whole image is programmed, or STREAM_ERROR.
+ */
+uint8_t Stream_Decode(void)
+{
+    uint8_t data = 0;
+#if (BOOT_FEATURE_LZ4 || BOOT_FEATURE_PATCH)
+    uint8_t result = 0;
+#endif
+
+    while (stream_tail != stream_head && STREAM_BUSY == stream_status)
+    {
+        data = stream_buffer[stream_tail];
+        stream_tail = (stream_tail + 1) % STREAM_BUFFER_SIZE;
+        IMAGE_Decrypt(update_address + stream_offset, &data, 1);
+        stream_offset++;
+        if (STREAM_FORMAT_PATCH == stream_format)
+        {
+#if BOOT_FEATURE_PATCH
+            result = PATCH_Decode_Byte(&patcher, data);
+            stream_status = (PATCH_DONE == result) ? STREAM_DONE : ((PATCH_ERROR == result) ? STREAM_ERROR : STREAM_BUSY);
+#endif
+        }
+        else
+        {
+#if BOOT_FEATURE_LZ4
+            result = LZ4_Decode_Byte(&decompressor, data);
+            stream_status = (LZ4_DONE == result) ? STREAM_DONE : ((LZ4_ERROR == result) ? STREAM_ERROR : STREAM_BUSY);
+#endif
+        }
+        if (STREAM_DONE == stream_status)
+        {
+            Stream_Flush();
+            if (STREAM_FORMAT_PATCH == stream_format)
+            {
+                send_string(" Patch applied\r\n"); /* The host may send the remaining records */
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    if (stream_overflow || output_error || (STREAM_DONE == stream_status && stream_tail != stream_head))
+    {
+        stream_status = STREAM_ERROR; /* Also bytes past the end of the frame or patch */
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    return stream_status;
+}
+#endif
+
+/*
+ *@brief Sends FRAME_ACK or FRAME_NAK followed by a sequence number.
+ *@param Code FRAME_ACK or FRAME_NAK.
+ *@param Sequence The sequence number.
+ *@returns None
+ */
+void Frame_Reply(uint8_t Code, uint8_t Sequence)
+{
+    send_bytes(Code);
+    send_bytes(Sequence);
+}
+
+/*
+ *@brief Decides whether a received frame is the next one to process.
+ *@details Frames are processed in sequence order. A corrupted frame is dropped and requested again. A frame ahead of
+ *         the expected one stays in its queue element (QUEUE_STATE_HELD) and the missing frame is requested; the held
+ *         frame is processed once the missing one is. A frame already processed is dropped and the last
+ *         acknowledgement repeated, since the host did not get it.
+ *@param Element Pointer to the queue element holding the frame.
+ *@returns 1 if the frame is the expected one; 0 otherwise.
+ */
+uint8_t Frame_Accept(volatile Queue *Element)
+{
+    uint8_t distance = (uint8_t)(Element->record[FRAME_SEQUENCE_INDEX] - frame_expected); /* Sequence numbers wrap */
+    uint8_t result = 0;
+    uint8_t i = 0;
+
+    if (QUEUE_STATE_HELD != Element->state && !FRAME_Check(Element->record))
+    {
+        Element->state = 0;
+        Frame_Reply(FRAME_NAK, frame_expected); /* The corrupted frame is the expected one or comes after it */
+    }
+    else if (0 == distance)
+    {
+        result = 1;
+    }
+    else if (FRAME_WINDOW > distance)
+    {
+        if (QUEUE_STATE_HELD != Element->state)
+        {
+            Element->state = QUEUE_STATE_HELD;
+            for (i = 0; i < NUMBER_OF_QUEUES; i++)
+            {
+                if (&queue[i] != Element && QUEUE_STATE_HELD == queue[i].state &&
+                    queue[i].record[FRAME_SEQUENCE_INDEX] == Element->record[FRAME_SEQUENCE_INDEX])
+                {
+                    Element->state = 0; /* Held already, a copy would only take the element the missing frame needs */
+                }
+                else
+                {
+                    /* Do nothing */
+                }
+            }
+            Frame_Reply(FRAME_NAK, frame_expected);
+        }
+        else
+        {
+            /* Still waiting for the missing frame */
+        }
+    }
+    else
+    {
+        Element->state = 0;
+        Frame_Reply(FRAME_ACK, (uint8_t)(frame_expected - 1)); /* Already processed */
+    }
+
+    return result;
+}
+
+#if BOOT_FEATURE_YMODEM
+/*
+ *@brief Ends the S-record line being collected from a YMODEM file.
+ *@details The line goes to the update loop, except an end line (S7, S8 or S9), which is kept until the transfer is
+ *         over so that the update is not finished before the terminal program got its last acknowledgement.
+ *@param None
+ *@returns None
+ */
+void Ymodem_End_Line(void)
+{
+    uint8_t i = 0;
+
+    queue[ymodem_element].record[ymodem_line] = '\0';
+    if ('S' == queue[ymodem_element].record[0] && '7' <= queue[ymodem_element].record[1] && '9' >= queue[ymodem_element].record[1])
+    {
+        for (i = 0; i <= ymodem_line; i++)
+        {
+            ymodem_end_record[i] = queue[ymodem_element].record[i];
+        }
+    }
+    else
+    {
+        queue[ymodem_element].state = 1; /* Processed by the update loop like a received line */
+    }
+    ymodem_line = 0;
+    ymodem_element = find_queue_empty(queue);
+}
+
+/*
+ *@brief Hands the data of the current block over to the queue.
+ *@details An S-record file is split into lines; a binary file becomes data frames of up to FRAME_MAX_PAYLOAD bytes
+ *         for consecutive addresses from the start of the slot being updated, so a 1 KB block fills one flash sector.
+ *         Bytes past the file size announced in block 0 are padding and are dropped.
+ *@param None
+ *@returns 1 once the whole block is handed over; 0 if the queue is full.
+ */
+uint8_t Ymodem_Hand_Over(void)
+{
+    uint16_t length = 0;
+    uint8_t data = 0;
+
+    ymodem_element = (NUMBER_OF_QUEUES > ymodem_element) ? ymodem_element : find_queue_empty(queue);
+    while (ymodem_offset < ymodem.Length && 0 != ymodem_remaining && NUMBER_OF_QUEUES > ymodem_element)
+    {
+        if (YMODEM_PAYLOAD_BINARY == ymodem_payload)
+        {
+            length = ymodem.Length - ymodem_offset;
+            length = (FRAME_MAX_PAYLOAD < length) ? FRAME_MAX_PAYLOAD : length;
+            length = (ymodem_remaining < length) ? ymodem_remaining : length;
+            FRAME_Build(queue[ymodem_element].record, '1', 0, ymodem_address, &ymodem.Data[ymodem_offset], length);
+            queue[ymodem_element].state = 1;
+            ymodem_address += length;
+            ymodem_offset += length;
+            ymodem_remaining -= length;
+            ymodem_element = find_queue_empty(queue);
+        }
+        else
+        {
+            data = ymodem.Data[ymodem_offset++];
+            ymodem_remaining--;
+            if ('\n' == data)
+            {
+                Ymodem_End_Line();
+            }
+            else if (YMODEM_SUB == data)
+            {
+                /* Padding of the last block */
+            }
+            else
+            {
+                queue[ymodem_element].record[ymodem_line++] = data;
+                if (MAX_LINE_LENGTH_RECORD - 1 <= ymodem_line)
+                {
+                    ymodem_line = 0; /* Not a record, dropped like an overlong received line */
+                }
+                else
+                {
+                    /* Do nothing */
+                }
+            }
+        }
+    }
+    if (0 == ymodem_remaining)
+    {
+        ymodem_offset = ymodem.Length; /* End of the file, the rest is padding */
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    return (ymodem.Length == ymodem_offset) ? 1 : 0;
+}
+
+/*
+ *@brief Handles a valid XMODEM-1K / YMODEM block.
+ *@param None
+ *@returns None
+ */
+void Ymodem_Block(void)
+{
+    if (0 == ymodem.Number && YMODEM_PHASE_DATA != ymodem_phase)
+    {
+        send_bytes(YMODEM_ACK);
+        if (YMODEM_PHASE_CLOSE == ymodem_phase || '\0' == ymodem.Data[0])
+        {
+            ymodem_phase = YMODEM_PHASE_DONE; /* Empty block 0: end of the batch */
+        }
+        else
+        {
+            ymodem_remaining = YMODEM_File_Size(&ymodem); /* YMODEM block 0: file name and size */
+            ymodem_batch = 1;
+            ymodem_phase = YMODEM_PHASE_DATA;
+            send_bytes(YMODEM_CRC_REQUEST); /* Requests the data blocks */
+        }
+    }
+    else if (ymodem_next == ymodem.Number && YMODEM_PHASE_CLOSE != ymodem_phase)
+    {
+        if (YMODEM_PAYLOAD_NONE == ymodem_payload)
+        {
+            ymodem_payload = ('S' == ymodem.Data[0] && '0' <= ymodem.Data[1] && '9' >= ymodem.Data[1]) ? YMODEM_PAYLOAD_SREC
+                                                                                                       : YMODEM_PAYLOAD_BINARY;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        ymodem_phase = YMODEM_PHASE_DATA;
+        ymodem_next++;
+        ymodem_offset = 0;
+        ymodem_block = YMODEM_BLOCK_HANDING;
+    }
+    else if ((uint8_t)(ymodem_next - 1) == ymodem.Number)
+    {
+        send_bytes(YMODEM_ACK); /* Block already handed over, its acknowledgement was lost */
+    }
+    else
+    {
+        Stop_Update("Transfer out of sequence\r\n");
+    }
+}
+
+/*
+ *@brief Runs the XMODEM-1K / YMODEM receiver.
+ *@details Until the session is selected, YMODEM_CRC_REQUEST is sent about every second to start a transfer in a
+ *         terminal program. Received blocks are handed over to the queue, where the update loop processes them like
+ *         received lines or frames; a block is acknowledged only once its data is processed, which paces the
+ *         terminal program to the flash programming. When the transfer is over the update loop gets the end line of
+ *         the file, or an end frame for a binary file, and finishes the update.
+ *@param None
+ *@returns None
+ */
+void Ymodem_Step(void)
+{
+    uint8_t data = 0;
+
+    if (SESSION_UNKNOWN == session_format)
+    {
+        if (SysTick->CTRL & SysTick_CTRL_COUNTFLAG_Msk) /* Reading clears the flag */
+        {
+            ymodem_polls++;
+            if (YMODEM_POLL_WRAPS <= ymodem_polls)
+            {
+                ymodem_polls = 0;
+                send_bytes(YMODEM_CRC_REQUEST);
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    else if (SESSION_YMODEM != session_format)
+    {
+        /* S-record lines or frames */
+    }
+    else if (YMODEM_PHASE_DONE != ymodem_phase)
+    {
+        if (YMODEM_BLOCK_HANDED == ymodem_block)
+        {
+            ymodem_block = YMODEM_BLOCK_NONE;
+            send_bytes(YMODEM_ACK); /* The data of the block is processed */
+        }
+        else if (YMODEM_BLOCK_HANDING == ymodem_block && Ymodem_Hand_Over())
+        {
+            ymodem_block = YMODEM_BLOCK_HANDED;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        while (YMODEM_BLOCK_NONE == ymodem_block && YMODEM_PHASE_DONE != ymodem_phase && stream_tail != stream_head)
+        {
+            data = stream_buffer[stream_tail];
+            stream_tail = (stream_tail + 1) % STREAM_BUFFER_SIZE;
+            switch (YMODEM_Receive_Byte(&ymodem, data))
+            {
+            case YMODEM_BLOCK:
+            {
+                Ymodem_Block();
+                break;
+            }
+            case YMODEM_END:
+            {
+                send_bytes(YMODEM_ACK);
+                if (ymodem_batch && YMODEM_PHASE_DATA == ymodem_phase)
+                {
+                    ymodem_phase = YMODEM_PHASE_CLOSE;
+                    send_bytes(YMODEM_CRC_REQUEST); /* Requests the block 0 ending the batch */
+                }
+                else if (YMODEM_PHASE_CLOSE != ymodem_phase)
+                {
+                    ymodem_phase = YMODEM_PHASE_DONE; /* End of an XMODEM-1K transfer */
+                }
+                else
+                {
+                    /* End of file repeated */
+                }
+                break;
+            }
+            case YMODEM_CANCEL:
+            {
+                ymodem_phase = YMODEM_PHASE_DONE;
+                Stop_Update("Transfer cancelled\r\n");
+                break;
+            }
+            case YMODEM_ERROR:
+            {
+                stream_tail = stream_head; /* Drops the rest of the corrupted block */
+                send_bytes(YMODEM_NAK);
+                break;
+            }
+            default:
+            {
+                /* Do nothing */
+                break;
+            }
+            }
+        }
+    }
+    else if (YMODEM_BLOCK_NONE != ymodem_block)
+    {
+        /* End record handed over */
+    }
+    else if (0 != ymodem_line)
+    {
+        Ymodem_End_Line(); /* Last line without a line feed, processed before the end record */
+    }
+    else
+    {
+        /* All handed-over data is processed now, the end record comes last */
+        ymodem_element = find_queue_empty(queue);
+        if ('S' == ymodem_end_record[0])
+        {
+            for (data = 0; '\0' != ymodem_end_record[data]; data++)
+            {
+                queue[ymodem_element].record[data] = ymodem_end_record[data];
+            }
+            queue[ymodem_element].record[data] = '\0';
+        }
+        else
+        {
+            FRAME_Build(queue[ymodem_element].record, '9', 0, update_address, ymodem.Data, 0); /* Binary file */
+        }
+        queue[ymodem_element].state = 1;
+        ymodem_block = YMODEM_BLOCK_HANDED; /* Nothing more to hand over */
+    }
+}
+#endif
+
+/*
+ * @brief  UART0 Interrupt Handler
+ * @details  Handles the UART0 interrupt triggered when the Receive Data Register Full (RDRF) flag is set.
+ *           Reads the received data, processes commands terminated by newline characters, and manages the command queue.
+ * @param  None
+ * @returns  None
+ */
+void Implement_UART_0_IRQHandler(void)
+{
+    if (S1_RDRF_FULL == DRIVER_UART_S1_Receive_Data_Register_Full_Flag((UART_Type *)UART0))
+    {
+        received_data = DRIVER_UART_D_Read_receive_data_buffer((UART_Type *)UART0); /* Read and return the received character */
+
+#if BOOT_FEATURE_YMODEM
+        if (SESSION_UNKNOWN == session_format && (YMODEM_SOH == received_data || YMODEM_STX == received_data))
+        {
+            session_format = SESSION_YMODEM; /* First block of an XMODEM-1K or YMODEM transfer */
+        }
+        else
+        {
+            /* Do nothing */
+        }
+#endif
+
+#if BOOT_FEATURE_STREAM
+        if (0 != stream_remaining || SESSION_YMODEM == session_format) /* Raw bytes of a compressed image or a patch, or YMODEM blocks */
+        {
+            if ((stream_head + 1) % STREAM_BUFFER_SIZE != stream_tail)
+            {
+                stream_buffer[stream_head] = received_data;
+                stream_head = (stream_head + 1) % STREAM_BUFFER_SIZE;
+            }
+            else
+            {
+                stream_overflow = 1; /* The host sent faster than the flash is programmed */
+            }
+            if (0 != stream_remaining)
+            {
+                stream_remaining--;
+            }
+            else
+            {
+                /* YMODEM blocks are paced by their acknowledgements */
+            }
+        }
+        else
+#endif
+        if (SESSION_UNKNOWN == session_format && FRAME_HANDSHAKE == received_data)
+        {
+            session_format = SESSION_FRAME; /* Binary frames follow */
+        }
+        else if (SESSION_FRAME == session_format)
+        {
+            if (0 == buffer_index && NUMBER_OF_QUEUES <= index_empty)
+            {
+                index_empty = find_queue_empty(queue); /* Queue was full at the end of the last frame */
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            if (NUMBER_OF_QUEUES <= index_empty)
+            {
+                /* Queue still full, the frame is dropped and sent again by the host */
+            }
+            else if (FRAME_Collect(queue[index_empty].record, &buffer_index, received_data)) /* Save data to queue */
+            {
+                queue[index_empty].state = 1;          /* Enables the state of having data at the element */
+                index_empty = find_queue_empty(queue); /* Find empty queue to save next data*/
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+        else
+        {
+            session_format = SESSION_SREC;
+            if (received_data == '\n') /* Check if the received data is a newline character (indicating end of command). */
+            {
+                queue[index_empty].record[buffer_index] = '\0'; /* Null-terminate the command string. */
+                queue[index_empty].number = line_count++;       /* Lines are processed in arrival order */
+                queue[index_empty].state = 1;                   /* Enables the state of having data at the element */
+                index_empty = find_queue_empty(queue);          /* Find empty queue to save next data*/
+                buffer_index = 0;                               /* Reset the buffer index for the next command. */
+            }
+            else
+            {
+                queue[index_empty].record[buffer_index++] = received_data; /* Save data to queue */
+                if (MAX_LINE_LENGTH_RECORD - 1 <= buffer_index)            /* Check if the buffer index exceeds the buffer length (to avoid overflow). */
+                {
+                    buffer_index = 0; /* Reset the buffer index to handle the next command. */
+                }
+                else
+                {
+                    /* Do nothing */
+                }
+            }
+        }
+    }
+    else
+    {
+        /* Do Nothing */
+    }
+}
+
+/*
+ * @brief  Main function for the bootloader application
+ * @details  Initializes peripherals, handles UART0 interrupts, and processes incoming commands for bootloading.
+ *           It erases sectors, receives SREC file lines, parses them, and programs the flash memory.
+ * @param  None
+ * @returns  None
+ */
+int main(void)
+{
+    uint8_t i = 1;                 /* For loop */
+    uint8_t j = 0;                 /* For loop */
+    uint8_t number_of_4_bytes = 0; /* Number of 4 bytes to write to flash */
+    uint8_t data_length = 0;       /* Number of data bytes in the record */
+    uint8_t record_data[FRAME_MAX_PAYLOAD]; /* All data bytes of the record */
+    uint8_t frame_acknowledged = 0; /* FRAME_HANDSHAKE_ACK sent */
+    uint8_t byte_count = 0;        /* Byte count in record line */
+    uint8_t address_size = 0;      /* Address bytes of the record line */
+    Record record_struct;          /*  contains information of 1 record line*/
+    uint8_t update_requested = 0;  /* Application request or SW2 pressed at reset */
+    uint8_t boot_slot = SLOT_A;    /* Slot started when no update is requested */
+    BOOT_Image_Status image_status = IMAGE_VALID; /* Result of the application image check */
+    Image_Header image_header;                   /* Header of the image being received */
+    uint8_t header_received = 0;                 /* Stream started with an image header record */
+    uint32_t slot_end = 0;                       /* End of the erased region, 0 until the first record */
+    uint32_t image_end = APPLICATION_ADDRESS;    /* End of the highest word written */
+    uint8_t image_digest[SHA256_DIGEST_SIZE];    /* Expected SHA-256 of the image */
+    uint8_t digest_received = 0;                 /* Stream carried an image digest record */
+#if BOOT_FEATURE_SIGNATURE
+    uint8_t image_signature[ECDSA_P256_SIGNATURE_SIZE]; /* Signature r || s of the image digest */
+    uint8_t signature_parts = 0;                 /* Bit 0: r received, bit 1: s received */
+#endif
+#if BOOT_FEATURE_ENCRYPTION
+    uint8_t image_counter[AES128_BLOCK_SIZE];    /* AES-CTR counter of image offset 0 */
+#endif
+#if (BOOT_FEATURE_LZ4 || BOOT_FEATURE_PATCH)
+    uint32_t stream_length = 0;                  /* Raw bytes announced by a compressed image or patch record */
+#endif
+    uint32_t line_expected = 0;                  /* Arrival number of the next S-record line to process */
+    uint32_t resent_lines = 0;                   /* Lines processed so far that were sent again after a NAK */
+    uint16_t missing_records = 0;                /* Records NAKed and not received again yet */
+    uint32_t resume_address = APPLICATION_ADDRESS; /* Data below was kept from an interrupted update */
+    uint8_t update_slot = SLOT_B;                /* Slot receiving the update */
+
+    GPIO_PIN_STATE Red_Led_State = LOW;   /* State of the red LED. */
+    GPIO_PIN_STATE Green_Led_State = LOW; /* State of the green LED. */
+
+    TIMESTAMP_Record(TIMESTAMP_MAIN);
+    Initialize_Clock_and_Pin_UART0(); /* Initialize clock and UART0 pins for communication. */
+    Initialize_UART0();               /* Configure UART0 for receiving and sending data. */
+    Initialize_Red_Led();             /* Initialize the red LED GPIO pin. */
+    Initialize_Green_Led();           /* Initialize the green LED GPIO pin. */
+    Initialize_Switch_2();            /* Initialize the Switch pin. */
+    TIMESTAMP_Record(TIMESTAMP_PERIPHERALS);
+
+    while (1) /* Main loop to continuously check for incoming commands and process them. */
+    {
+        update_requested = Check_Update_Request();                                 /* Requested by the application */
+        update_requested |= !DRIVER_GPIO_PDIR_Read_Input_Pin(GPIOC, PIN_SWITCH_2); /* SW2 pressed at reset */
+        if (!update_requested)
+        {
+            update_requested = Wait_For_Sync(Boot_Sync_Window()); /* Host tool or production fixture */
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        TIMESTAMP_Record(TIMESTAMP_BOOT_MODE);
+        if (!update_requested)
+        {
+            boot_slot = SLOT_Boot(); /* Rolls back a new image never confirmed by the application */
+            image_status = Check_Application_Image(IMAGE_SLOT_ADDRESS(boot_slot)); /* Never jump into an erased or half-written slot */
+            if (IMAGE_VALID != image_status && IMAGE_VALID == Check_Application_Image(IMAGE_SLOT_ADDRESS(SLOT_OTHER(boot_slot))))
+            {
+                boot_slot = SLOT_OTHER(boot_slot); /* The other slot still holds a startable image */
+                SLOT_Select(boot_slot);
+                image_status = IMAGE_VALID;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+            TIMESTAMP_Record(TIMESTAMP_IMAGE_CHECKED);
+        }
+        else
+        {
+            /* Not booting, so the boot is not logged */
+        }
+
+        if (update_requested || IMAGE_VALID != image_status)
+        {
+            TIMESTAMP_Record(TIMESTAMP_UPDATE_MODE);
+            DRIVER_GPIO_Output_Pin_State(GPIOE, PIN_RED_LED, LOW); /* Turn on the RED LED */
+            if (IMAGE_VALID != image_status)
+            {
+                send_string(" \n");
+                send_string(" No valid application found, staying in bootloader mode\r\n");
+            }
+            else
+            {
+                /* Entered on request */
+            }
+            Set_Clock_Profile(MCG_CLOCK_PROFILE_HIGH_SPEED);       /* Run the update session at 48 MHz core, 24 MHz bus */
+            initialize_state(queue); /* Initialize 'state' to 0*/
+            DRIVER_UART_S1_Clear_Overrun_Flag((UART_Type *)UART0);     /* Receiver may have overrun while polled */
+            DRIVER_NVIC_UART0_IRQHandler(Implement_UART_0_IRQHandler); /* Callback if interruption occurs */
+            DRIVER_NVIC_Enable_External_Interrupt(UART0_IRQn);         /* Enable External Interrupt UART0 */
+            send_string(" \n");
+            send_string(" |***************** BOOTLOADER *****************|\r\n");
+            send_string(" Preparing............\r\n");
+            Send_Timestamps(); /* Bootloader share of the boot time */
+            send_string(" \n");
+            send_string(" Please update SREC (file format) now !\r\n");
+            update_slot = SLOT_OTHER(SLOT_Active()); /* The running image stays intact */
+            update_address = IMAGE_SLOT_ADDRESS(update_slot);
+#if BOOT_FEATURE_YMODEM
+            ymodem_address = update_address;
+#endif
+            image_end = update_address;
+            resume_address = update_address;
+            IMAGE_Stream_Start(update_address); /* Hash the image while it is received */
+            while (1)
+            {
+                if (SESSION_FRAME == session_format && 0 == frame_acknowledged)
+                {
+                    send_bytes(FRAME_HANDSHAKE_ACK); /* The host may send frames */
+                    frame_acknowledged = 1;
+                }
+                else
+                {
+                    /* Do nothing */
+                }
+                for (i = 0; i < NUMBER_OF_QUEUES; i++)
+                {
+                    if (0 != queue[i].state && (SESSION_SREC != session_format || line_expected == queue[i].number) &&
+                        (SESSION_FRAME != session_format || Frame_Accept(&queue[i])))
+                    {
+                        if (FRAME_SYNC == (uint8_t)queue[i].record[0])
+                        {
+                            byte_count = FRAME_Parse(queue[i].record, &record_struct, record_data); /* Binary frame, nothing to convert */
+                        }
+                        else
+                        {
+                            byte_count = Check_Line_Record(queue[i].record);
+                            address_size = record_address_size(queue[i].record); /* S2 and S3 records reach slot B */
+                            if (address_size + 1 <= byte_count && FRAME_MAX_PAYLOAD + address_size + 1 >= byte_count)
+                            {
+                                record_parser(queue[i].record, &record_struct, byte_count);      /* Get data and adress*/
+                                record_data_parser(queue[i].record, record_data, byte_count); /* All data bytes */
+                                byte_count -= address_size - 2;                               /* Byte count of the equivalent S1 record */
+                            }
+                            else
+                            {
+                                byte_count = 0;
+                            }
+                        }
+                        if (SMALLEST_BYTES_COUNT_NUMBER > byte_count && SESSION_YMODEM == session_format)
+                        {
+                            /* The block passed its CRC, so the file itself is corrupted: cancel the transfer */
+                            Stop_Update("Corrupted record in the file\r\n");
+                        }
+                        else if (SMALLEST_BYTES_COUNT_NUMBER > byte_count)
+                        {
+                            /* Corrupted record: the host sends this line of its file (from 0) again, the update goes on */
+                            queue[i].state = 0;
+                            missing_records++;
+                            send_string(" NAK ");
+                            send_hex_word(queue[i].number - resent_lines); /* Lines sent again do not count */
+                            send_string("\r\n");
+                        }
+                        else
+                        {
+                            if (0 == slot_end && !(queue[i].record[1] == '0' && IMAGE_COUNTER_RECORD_BYTE_COUNT == byte_count &&
+                                                    IMAGE_RECORD_TAG_COUNTER == record_struct.address))
+                            {
+                                /* First record (the counter record changes nothing in flash and may come before it) */
+                                if (queue[i].record[1] == '0' && IMAGE_PATCH_RECORD_BYTE_COUNT == byte_count &&
+                                    IMAGE_RECORD_TAG_PATCH == record_struct.address)
+                                {
+#if BOOT_FEATURE_PATCH
+                                    /* Delta update: the image in the active slot is the base */
+                                    slot_end = Prepare_Patch_Slot(IMAGE_SLOT_ADDRESS(SLOT_OTHER(update_slot)), IMAGE_Bytes_To_Word(record_struct.data2),
+                                                                  IMAGE_Bytes_To_Word(record_struct.data3));
+#else
+                                    Stop_Update("Delta patches are not supported\r\n");
+#endif
+                                }
+                                else
+                                {
+                                    /* Erase only what the header announces, the whole slot otherwise */
+                                    if (queue[i].record[1] == '0')
+                                    {
+                                        header_received = IMAGE_Parse_Header_Record(&record_struct, byte_count, update_address, &image_header);
+                                    }
+                                    else
+                                    {
+                                        /* Do nothing */
+                                    }
+                                    if (header_received)
+                                    {
+                                        resume_address = JOURNAL_Resume_Point(&image_header); /* Same image as an interrupted update? */
+                                    }
+                                    else
+                                    {
+                                        /* Do nothing */
+                                    }
+                                    slot_end = Prepare_Image_Slot(resume_address, header_received ? IMAGE_Sectors_Required(image_header.Image_Length) : NUMBER_OF_SECTORS_TO_DELETE);
+                                    if (update_address < resume_address)
+                                    {
+                                        IMAGE_Stream_Data(update_address, (const uint8_t *)update_address, resume_address - update_address); /* Kept sectors */
+                                    }
+                                    else if (header_received)
+                                    {
+                                        __disable_irq();
+                                        JOURNAL_Start(&image_header); /* Lets the update resume if it is interrupted */
+                                        __enable_irq();
+                                    }
+                                    else
+                                    {
+                                        /* Plain S-record file, no identity to resume */
+                                    }
+                                }
+                            }
+                            else if (queue[i].record[1] == '0' && 0 == header_received)
+                            {
+                                header_received = IMAGE_Parse_Header_Record(&record_struct, byte_count, update_address, &image_header); /* Header after a patch */
+                            }
+                            else
+                            {
+                                /* Do nothing */
+                            }
+
+                            if (queue[i].record[1] == '0' && IMAGE_COUNTER_RECORD_BYTE_COUNT == byte_count &&
+                                IMAGE_RECORD_TAG_COUNTER == record_struct.address)
+                            {
+#if BOOT_FEATURE_ENCRYPTION
+                                Copy_Record_Data(image_counter, record_data, AES128_BLOCK_SIZE); /* Encrypted image: initial counter */
+                                IMAGE_Decrypt_Start(image_counter);
+#else
+                                Stop_Update("Encrypted images are not supported\r\n");
+#endif
+                            }
+                            else if (queue[i].record[1] == '0' && IMAGE_COMPRESSED_RECORD_BYTE_COUNT == byte_count &&
+                                     IMAGE_RECORD_TAG_COMPRESSED == record_struct.address)
+                            {
+#if BOOT_FEATURE_LZ4
+                                stream_length = IMAGE_Bytes_To_Word(record_struct.data1);
+                                if (0 == stream_length || IMAGE_SLOT_SIZE < stream_length || STREAM_FORMAT_NONE != stream_format || 0 != patch_base ||
+                                    SESSION_YMODEM == session_format)
+                                {
+                                    Stop_Update("Invalid compressed image record\r\n");
+                                }
+                                else
+                                {
+                                    Stream_Start(STREAM_FORMAT_LZ4, stream_length, slot_end, 0); /* Raw LZ4 frame follows, then the S9 record */
+                                    send_string(" Send the compressed image now\r\n");
+                                }
+#else
+                                Stop_Update("Compressed images are not supported\r\n");
+#endif
+                            }
+                            else if (queue[i].record[1] == '0' && IMAGE_PATCH_RECORD_BYTE_COUNT == byte_count &&
+                                     IMAGE_RECORD_TAG_PATCH == record_struct.address)
+                            {
+#if BOOT_FEATURE_PATCH
+                                stream_length = IMAGE_Bytes_To_Word(record_struct.data1);
+                                if (0 == stream_length || IMAGE_SLOT_SIZE < stream_length || STREAM_FORMAT_NONE != stream_format || 0 == patch_base ||
+                                    SESSION_YMODEM == session_format)
+                                {
+                                    Stop_Update("Invalid patch record\r\n"); /* Too large, or not the first record */
+                                }
+                                else
+                                {
+                                    Stream_Start(STREAM_FORMAT_PATCH, stream_length, slot_end, IMAGE_Bytes_To_Word(record_struct.data2));
+                                    send_string(" Send the patch now\r\n");
+                                }
+#else
+                                Stop_Update("Delta patches are not supported\r\n");
+#endif
+                            }
+                            else if (queue[i].record[1] == '0' && IMAGE_DIGEST_RECORD_BYTE_COUNT == byte_count)
+                            {
+#if BOOT_FEATURE_SIGNATURE
+                                if (IMAGE_RECORD_TAG_DIGEST == record_struct.address)
+                                {
+                                    Copy_Record_Data(image_digest, record_data, SHA256_DIGEST_SIZE); /* Expected image digest */
+                                    digest_received = 1;
+                                }
+                                else if (IMAGE_RECORD_TAG_SIGNATURE_R == record_struct.address)
+                                {
+                                    Copy_Record_Data(image_signature, record_data, SHA256_DIGEST_SIZE); /* Signature r */
+                                    signature_parts |= 0x1u;
+                                }
+                                else if (IMAGE_RECORD_TAG_SIGNATURE_S == record_struct.address)
+                                {
+                                    Copy_Record_Data(&image_signature[SHA256_DIGEST_SIZE], record_data, SHA256_DIGEST_SIZE); /* Signature s */
+                                    signature_parts |= 0x2u;
+                                }
+                                else
+                                {
+                                    /* Do nothing */
+                                }
+                                if (digest_received && 0x3u == signature_parts)
+                                {
+                                    IMAGE_Signature_Start(image_digest, image_signature); /* Verified in the idle time of the transfer */
+                                }
+                                else
+                                {
+                                    /* Do nothing */
+                                }
+#else
+                                Stop_Update("Signed images are not supported\r\n");
+#endif
+                            }
+                            else
+                            {
+                                /* Do nothing */
+                            }
+
+                            if ('1' <= queue[i].record[1] && '3' >= queue[i].record[1])
+                            {
+                                data_length = byte_count - SMALLEST_BYTES_COUNT_NUMBER;
+                                number_of_4_bytes = (data_length + NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME - 1) / NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME; /* Because each write to flash is 4 bytes */
+                                if (update_address > record_struct.address ||
+                                    slot_end < record_struct.address + number_of_4_bytes * NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME)
+                                {
+                                    Stop_Update("Record outside the application slot\r\n");
+                                }
+                                else
+                                {
+                                    /* Do nothing */
+                                }
+                                for (j = data_length; j < number_of_4_bytes * NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME; j++)
+                                {
+                                    record_data[j] = 0xFF; /* Erased tail of a partial last word */
+                                }
+                                for (j = 0; j < number_of_4_bytes; j++)
+                                {
+                                    if (resume_address <= record_struct.address + j * NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME)
+                                    {
+                                        Program_Record_Word(record_struct.address + j * NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME,
+                                                            &record_data[j * NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME]); /* Decrypt, program and hash one word */
+                                        JOURNAL_Record_Progress(record_struct.address + j * NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME,
+                                                                NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME); /* Journals the sectors completed */
+                                    }
+                                    else
+                                    {
+                                        /* Kept from the interrupted update */
+                                    }
+                                }
+                                if (0 != missing_records && image_end > record_struct.address)
+                                {
+                                    missing_records--; /* Going backwards: a record sent again after a NAK */
+                                    resent_lines++;
+                                }
+                                else
+                                {
+                                    /* Do nothing */
+                                }
+                                if (image_end < record_struct.address + number_of_4_bytes * NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME)
+                                {
+                                    image_end = record_struct.address + number_of_4_bytes * NUMBER_OF_BYTES_WRITTEN_DOWN_AT_ONE_TIME; /* Highest address written so far */
+                                }
+                                else
+                                {
+                                    /* Do nothing */
+                                }
+
+                                send_string(".");
+                            }
+                            else
+                            {
+                                /* Do nothing */
+                            }
+
+                            queue[i].state = 0; /* Returns empty state ready to receive data */
+                            if (SESSION_FRAME == session_format)
+                            {
+                                Frame_Reply(FRAME_ACK, frame_expected); /* Acknowledges this frame and every frame before it */
+                                frame_expected++;
+                            }
+                            else
+                            {
+                                /* Do nothing */
+                            }
+
+                            if ('7' <= queue[i].record[1] && '9' >= queue[i].record[1])
+                            {
+#if (BOOT_FEATURE_LZ4 || BOOT_FEATURE_PATCH)
+                                if (STREAM_FORMAT_NONE != stream_format)
+                                {
+                                    /* All raw bytes were received before the end record, decode what is left */
+                                    if (STREAM_DONE != Stream_Decode())
+                                    {
+                                        Stop_Update("Image stream incomplete\r\n");
+                                    }
+                                    else if (image_end < output_address)
+                                    {
+                                        image_end = output_address;
+                                    }
+                                    else
+                                    {
+                                        /* Do nothing */
+                                    }
+                                }
+                                else
+                                {
+                                    /* Do nothing */
+                                }
+#endif
+                                if (0 == header_received)
+                                {
+                                    /* Plain S-record file: describe what was received */
+                                    image_header.Load_Address = update_address;
+                                    image_header.Image_Length = image_end - update_address;
+                                    image_header.Image_Version = 0;
+                                    image_header.Image_CRC32 = IMAGE_Compute_CRC32(update_address, image_header.Image_Length);
+                                }
+                                else if (image_header.Image_CRC32 != IMAGE_Compute_CRC32(update_address, image_header.Image_Length))
+                                {
+                                    Stop_Update("Image CRC mismatch\r\n");
+                                }
+                                else
+                                {
+                                    /* Received image matches the header */
+                                }
+                                if (digest_received && !IMAGE_Stream_Check_Digest(&image_header, image_digest))
+                                {
+                                    Stop_Update("Image digest mismatch\r\n");
+                                }
+                                else
+                                {
+                                    /* Image is the one the host built, or no digest was sent */
+                                }
+                                if (IMAGE_REQUIRE_SIGNATURE && ECDSA_VALID != IMAGE_Signature_Finish())
+                                {
+                                    Stop_Update("Image signature invalid\r\n");
+                                }
+                                else
+                                {
+                                    /* Image signed by the release key, or signatures are not required */
+                                }
+                                __disable_irq();
+                                IMAGE_Write_Header(&image_header); /* Written last: the image becomes bootable only now */
+                                JOURNAL_Clear();                   /* Nothing to resume any more */
+                                SLOT_Activate(update_slot);        /* Boots next, on trial until the application confirms it */
+                                __enable_irq();
+                                send_string(".done!\r\n");
+                                send_string("  \n");
+                                send_string("           +++++++++++++++++++++++++++++\n");
+                                send_string("  \n");
+                                send_string(" Please press the Reset Button to run the Application. Thanks :)\r\n");
+                                while (1)
+                                {
+                                    /* Do nothing */
+                                }
+                            }
+                            else
+                            {
+                                /* Do nothing */
+                            }
+                        }
+                        line_expected++;
+                    }
                     else
                     {
                         /* Do Nothing */
                     }
                 }
+#if BOOT_FEATURE_YMODEM
+                Ymodem_Step(); /* Hands XMODEM-1K / YMODEM blocks over to the queue */
+#endif
+#if (BOOT_FEATURE_LZ4 || BOOT_FEATURE_PATCH)
+                if (STREAM_FORMAT_NONE != stream_format && STREAM_ERROR == Stream_Decode())
+                {
+                    Stop_Update("Image stream corrupted\r\n");
+                }
+                else
+                {
+                    /* Do nothing */
+                }
+#endif
+                (void)IMAGE_Signature_Step(); /* Overlap the signature verification with the transfer */
             }
         }
         else
         {
             while (1)
             {
-                JumpToApplication(); /* Jump To Application to run Application */
+                __disable_irq();            /* No UART0 interrupt while the peripherals are torn down */
+                Deinitialize_Peripherals(); /* Hand the peripherals over in their reset state */
+                TIMESTAMP_Record(TIMESTAMP_JUMP);
+                JumpToApplication(IMAGE_SLOT_ADDRESS(boot_slot)); /* Jump To Application to run Application */
             }
         }
     }
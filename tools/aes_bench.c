@@ -0,0 +1,192 @@
+/**
+ * @file aes_bench.c
+ * @brief Host benchmark of the AES-128-CTR image decryption.
+ * @details This program builds Sources/AES128.c for the host and checks it against the FIPS-197 block vector and the
+ *          SP 800-38A CTR-AES128 vectors, through AES128_CTR_Crypt as IMAGE_Decrypt calls it: the key stream block of
+ *          image offset o is AES(Initial_Counter + o / 16). The vectors are also decrypted in reverse order, as records
+ *          sent again after a NAK are. It then decrypts an image one flash word at a time, the way records are
+ *          programmed, counts the calls and the key stream blocks, and turns them into Cortex-M0+ cycles per byte at
+ *          47.97 MHz, compared with the UART0 byte time at 115200 and 460800 baud (8N1).
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "AES128.h"
+#include "DRIVER/DRIVER_MCG.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define BENCH_IMAGE_SIZE (216u * 1024u) /* Largest application */
+#define BENCH_ROUNDS 20u                /* Decryptions timed */
+#define BENCH_WORD_SIZE 4u              /* Bytes programmed at once */
+#define BENCH_CHARACTER_BITS 10u        /* 8N1: start, 8 data, stop */
+#define BENCH_BAUD_RATE 115200u         /* UART0_BAUD_RATE of main.c */
+#define BENCH_BAUD_RATE_FAST 460800u    /* Fastest rate considered for UART0 */
+#define BENCH_CORE_CLOCK_HZ MCG_FLL_CLOCK_HIGH_SPEED_HZ /* MCG_CLOCK_PROFILE_HIGH_SPEED, set for the update */
+
+/*
+ * Cycles on the MKL46Z4 (Cortex-M0+, 2-cycle loads, built with -Os). A middle round of AES128_Encrypt_Block is
+ * 16 T-table lookups of about 7 cycles (shift, mask, scale, load, rotation) and the XOR of 4 round key words, with
+ * spills of the 8 state words over the low registers: about 150 cycles. The last round is 16 S-box lookups and the
+ * round key: about 140. The byte loads and stores of the block, the first round key and the call add about 150.
+ * AES128_CTR_Block adds the 16-byte counter addition, about 165. Each byte of AES128_CTR_Crypt (block test, load,
+ * XOR with the key stream, store, loop) takes about 18, and each IMAGE_Decrypt call about 25.
+ */
+#define BENCH_BLOCK_CYCLES (9u * 150u + 140u + 150u + 165u) /* AES128_CTR_Block */
+#define BENCH_BYTE_CYCLES 18u                               /* One byte of AES128_CTR_Crypt */
+#define BENCH_CALL_CYCLES 25u                               /* One IMAGE_Decrypt call */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+
+/* FIPS-197 appendix C.1 */
+static const uint8_t Block_Key[AES128_KEY_SIZE] = {0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+                                                   0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F};
+static const uint8_t Block_Plain[AES128_BLOCK_SIZE] = {0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+                                                       0x88, 0x99, 0xAA, 0xBB, 0xCC, 0xDD, 0xEE, 0xFF};
+static const uint8_t Block_Cipher[AES128_BLOCK_SIZE] = {0x69, 0xC4, 0xE0, 0xD8, 0x6A, 0x7B, 0x04, 0x30,
+                                                        0xD8, 0xCD, 0xB7, 0x80, 0x70, 0xB4, 0xC5, 0x5A};
+
+/* SP 800-38A F.5.1 CTR-AES128.Encrypt */
+static const uint8_t Ctr_Key[AES128_KEY_SIZE] = {0x2B, 0x7E, 0x15, 0x16, 0x28, 0xAE, 0xD2, 0xA6,
+                                                 0xAB, 0xF7, 0x15, 0x88, 0x09, 0xCF, 0x4F, 0x3C};
+static const uint8_t Ctr_Counter[AES128_BLOCK_SIZE] = {0xF0, 0xF1, 0xF2, 0xF3, 0xF4, 0xF5, 0xF6, 0xF7,
+                                                       0xF8, 0xF9, 0xFA, 0xFB, 0xFC, 0xFD, 0xFE, 0xFF};
+static const uint8_t Ctr_Plain[4u * AES128_BLOCK_SIZE] = {
+    0x6B, 0xC1, 0xBE, 0xE2, 0x2E, 0x40, 0x9F, 0x96, 0xE9, 0x3D, 0x7E, 0x11, 0x73, 0x93, 0x17, 0x2A,
+    0xAE, 0x2D, 0x8A, 0x57, 0x1E, 0x03, 0xAC, 0x9C, 0x9E, 0xB7, 0x6F, 0xAC, 0x45, 0xAF, 0x8E, 0x51,
+    0x30, 0xC8, 0x1C, 0x46, 0xA3, 0x5C, 0xE4, 0x11, 0xE5, 0xFB, 0xC1, 0x19, 0x1A, 0x0A, 0x52, 0xEF,
+    0xF6, 0x9F, 0x24, 0x45, 0xDF, 0x4F, 0x9B, 0x17, 0xAD, 0x2B, 0x41, 0x7B, 0xE6, 0x6C, 0x37, 0x10};
+static const uint8_t Ctr_Cipher[4u * AES128_BLOCK_SIZE] = {
+    0x87, 0x4D, 0x61, 0x91, 0xB6, 0x20, 0xE3, 0x26, 0x1B, 0xEF, 0x68, 0x64, 0x99, 0x0D, 0xB6, 0xCE,
+    0x98, 0x06, 0xF6, 0x6B, 0x79, 0x70, 0xFD, 0xFF, 0x86, 0x17, 0x18, 0x7B, 0xB9, 0xFF, 0xFD, 0xFF,
+    0x5A, 0xE4, 0xDF, 0x3E, 0xDB, 0xD5, 0xD3, 0x5E, 0x5B, 0x4F, 0x09, 0x02, 0x0D, 0xB0, 0x3E, 0xAB,
+    0x1E, 0x03, 0x1D, 0xDA, 0x2F, 0xBE, 0x03, 0xD1, 0x79, 0x21, 0x70, 0xA0, 0xF3, 0x00, 0x9C, 0xEE};
+
+static AES128_Context cipher;
+static AES128_CTR_Context ctr;
+static uint8_t image[BENCH_IMAGE_SIZE];
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *@brief Checks the block cipher and the CTR mode against the reference vectors.
+ *@returns Number of failures.
+ */
+static uint32_t Check_Vectors(void)
+{
+    uint32_t failures = 0;
+    uint8_t buffer[sizeof(Ctr_Cipher)];
+    uint32_t offset = 0;
+
+    AES128_Init(&cipher, Block_Key);
+    AES128_Encrypt_Block(&cipher, Block_Plain, buffer);
+    if (0 != memcmp(buffer, Block_Cipher, AES128_BLOCK_SIZE))
+    {
+        printf("FAIL FIPS-197 C.1\n");
+        failures++;
+    }
+
+    memcpy(buffer, Ctr_Cipher, sizeof(buffer));
+    AES128_CTR_Init(&ctr, Ctr_Key, Ctr_Counter);
+    for (offset = 0; offset < sizeof(buffer); offset += BENCH_WORD_SIZE)
+    {
+        AES128_CTR_Crypt(&ctr, offset, &buffer[offset], BENCH_WORD_SIZE);
+    }
+    if (0 != memcmp(buffer, Ctr_Plain, sizeof(buffer)))
+    {
+        printf("FAIL SP 800-38A F.5.2, in order\n");
+        failures++;
+    }
+
+    memcpy(buffer, Ctr_Cipher, sizeof(buffer));
+    AES128_CTR_Init(&ctr, Ctr_Key, Ctr_Counter);
+    for (offset = sizeof(buffer); 0 != offset; offset -= BENCH_WORD_SIZE)
+    {
+        AES128_CTR_Crypt(&ctr, offset - BENCH_WORD_SIZE, &buffer[offset - BENCH_WORD_SIZE], BENCH_WORD_SIZE);
+    }
+    if (0 != memcmp(buffer, Ctr_Plain, sizeof(buffer)))
+    {
+        printf("FAIL SP 800-38A F.5.2, reverse order\n");
+        failures++;
+    }
+
+    return failures;
+}
+
+int main(void)
+{
+    uint32_t failures = Check_Vectors();
+    uint32_t round = 0;
+    uint32_t offset = 0;
+    uint32_t calls = 0;
+    uint32_t blocks = 0;
+    uint32_t index = 0;
+    clock_t start = 0;
+    double rate = 0;
+    double cycles = 0;
+
+    /* Target work of one image, word by word */
+    AES128_CTR_Init(&ctr, Ctr_Key, Ctr_Counter);
+    index = ctr.Key_Stream_Index;
+    for (offset = 0; offset < BENCH_IMAGE_SIZE; offset += BENCH_WORD_SIZE)
+    {
+        AES128_CTR_Crypt(&ctr, offset, &image[offset], BENCH_WORD_SIZE);
+        calls++;
+        if (index != ctr.Key_Stream_Index)
+        {
+            index = ctr.Key_Stream_Index;
+            blocks++;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+    cycles = ((double)calls * BENCH_CALL_CYCLES + (double)BENCH_IMAGE_SIZE * BENCH_BYTE_CYCLES +
+              (double)blocks * BENCH_BLOCK_CYCLES) / BENCH_IMAGE_SIZE;
+
+    /* Host time, for regressions */
+    start = clock();
+    for (round = 0; round < BENCH_ROUNDS; round++)
+    {
+        for (offset = 0; offset < BENCH_IMAGE_SIZE; offset += BENCH_WORD_SIZE)
+        {
+            AES128_CTR_Crypt(&ctr, offset, &image[offset], BENCH_WORD_SIZE);
+        }
+    }
+    rate = (double)BENCH_IMAGE_SIZE * BENCH_ROUNDS / ((double)(clock() - start) / CLOCKS_PER_SEC);
+
+    printf("AES-128-CTR on the target at %.2f MHz: %u cycles per key stream block, %.1f cycles per byte, %.2f us\n",
+           BENCH_CORE_CLOCK_HZ / 1e6, (unsigned)BENCH_BLOCK_CYCLES, cycles, cycles * 1e6 / BENCH_CORE_CLOCK_HZ);
+    printf("  UART0 byte time: %.0f cycles, %.1f us at %u baud; %.0f cycles, %.1f us at %u baud\n",
+           (double)BENCH_CORE_CLOCK_HZ * BENCH_CHARACTER_BITS / BENCH_BAUD_RATE,
+           1e6 * BENCH_CHARACTER_BITS / BENCH_BAUD_RATE, (unsigned)BENCH_BAUD_RATE,
+           (double)BENCH_CORE_CLOCK_HZ * BENCH_CHARACTER_BITS / BENCH_BAUD_RATE_FAST,
+           1e6 * BENCH_CHARACTER_BITS / BENCH_BAUD_RATE_FAST, (unsigned)BENCH_BAUD_RATE_FAST);
+    if (cycles >= (double)BENCH_CORE_CLOCK_HZ * BENCH_CHARACTER_BITS / BENCH_BAUD_RATE_FAST)
+    {
+        printf("FAIL: a byte takes longer to decrypt than to receive at %u baud\n", (unsigned)BENCH_BAUD_RATE_FAST);
+        failures++;
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    printf("AES-128-CTR: vectors %s, %.1f KB/s on the host\n", (0 == failures) ? "ok" : "FAILED", rate / 1024.0);
+
+    return (0 == failures) ? 0 : 1;
+}
+
+/* EOF */
@@ -0,0 +1,117 @@
+/**
+ * @file crc32_bench.c
+ * @brief Host benchmark of the CRC-32 engine.
+ * @details This program builds Sources/CRC32.c for the host, checks it against the reference vectors of CRC-32
+ *          (IEEE 802.3), then times a full check of an application slot. The makefile builds it once per table size.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "CRC32.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define BENCH_IMAGE_SIZE (216u * 1024u) /* Largest application checked at boot */
+#define BENCH_ROUNDS 200u               /* Checks timed */
+
+/*
+ *@brief Reference vector.
+ */
+typedef struct Bench_Vector
+{
+    const char *Data; /**< Input, without the terminating null */
+    uint32_t CRC32;   /**< Expected CRC-32 */
+} Bench_Vector;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static const Bench_Vector Vectors[] = {
+    {"", 0x00000000u},
+    {"a", 0xE8B7BE43u},
+    {"abc", 0x352441C2u},
+    {"123456789", 0xCBF43926u},
+    {"The quick brown fox jumps over the lazy dog", 0x414FA339u},
+};
+
+static uint8_t image[BENCH_IMAGE_SIZE + 4u];
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *@brief Checks the engine against the reference vectors, in one call and split at every byte boundary and alignment.
+ *@returns Number of failures.
+ */
+static uint32_t Check_Vectors(void)
+{
+    uint32_t failures = 0;
+    uint32_t i = 0;
+    uint32_t length = 0;
+    uint32_t split = 0;
+    uint32_t offset = 0;
+    uint32_t crc = 0;
+
+    for (i = 0; i < sizeof(Vectors) / sizeof(Vectors[0]); i++)
+    {
+        length = (uint32_t)strlen(Vectors[i].Data);
+        for (offset = 0; offset < 4u; offset++)
+        {
+            memcpy(&image[offset], Vectors[i].Data, length); /* Every alignment of the word loop */
+            if (Vectors[i].CRC32 != CRC32_Compute(&image[offset], length))
+            {
+                printf("FAIL \"%s\" offset %u\n", Vectors[i].Data, (unsigned)offset);
+                failures++;
+            }
+            for (split = 0; split <= length; split++)
+            {
+                crc = CRC32_Update(CRC32_Init(), &image[offset], split);
+                crc = CRC32_Final(CRC32_Update(crc, &image[offset + split], length - split));
+                if (Vectors[i].CRC32 != crc)
+                {
+                    printf("FAIL \"%s\" offset %u split %u\n", Vectors[i].Data, (unsigned)offset, (unsigned)split);
+                    failures++;
+                }
+            }
+        }
+    }
+
+    return failures;
+}
+
+int main(void)
+{
+    uint32_t failures = Check_Vectors();
+    uint32_t i = 0;
+    uint32_t crc = 0;
+    clock_t start = 0;
+    double seconds = 0;
+
+    for (i = 0; i < BENCH_IMAGE_SIZE; i++)
+    {
+        image[i] = (uint8_t)(i * 2654435761u >> 24); /* Arbitrary image contents */
+    }
+    start = clock();
+    for (i = 0; i < BENCH_ROUNDS; i++)
+    {
+        crc = CRC32_Compute(image, BENCH_IMAGE_SIZE);
+    }
+    seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+    printf("CRC32_TABLE_SIZE %d: vectors %s, %u KB in %.3f ms, %.1f MB/s (%08X)\n", CRC32_TABLE_SIZE,
+           (0 == failures) ? "ok" : "FAILED", BENCH_IMAGE_SIZE / 1024u, seconds * 1000.0 / BENCH_ROUNDS,
+           (double)BENCH_IMAGE_SIZE * BENCH_ROUNDS / seconds / 1e6, (unsigned)crc);
+
+    return (0 == failures) ? 0 : 1;
+}
+
+/* EOF */
@@ -0,0 +1,373 @@
+/**
+ * @file ecdsa_bench.c
+ * @brief Host benchmark of the ECDSA P-256 signature verification.
+ * @details This program builds Sources/ECDSA.c and Sources/SHA256.c for the host and runs the verification the way
+ *          the update loop does, one ECDSA_P256_Verify_Step per idle pass, over signatures made with the private key
+ *          of SIGNING_KEY.h. It checks the digest of each signed message, the result of each verification, and
+ *          reports the number of steps and the host time of a whole verification.
+ *          ECDSA.c is included here with ECDSA_PROBE counting its word-by-word operations. Their counts times the
+ *          Cortex-M0+ cycles of each give the time of the start and of each step on the target at 47.97 MHz, which
+ *          is compared with the time the record queue takes to fill at 115200 and 460800 baud:
+ *          IMAGE_Signature_Step runs while UART0 keeps receiving into that queue.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "SHA256.h"
+#include "SIGNING_KEY.h"
+#include "QUEUE.h"
+#include "DRIVER/DRIVER_MCG.h"
+
+/*
+ *@brief Operations of ECDSA.c counted through ECDSA_PROBE.
+ */
+typedef enum Bench_Operation
+{
+    BENCH_MONT_MUL, /**< ECDSA_Mont_Mul, without its final Compare, Sub and Copy */
+    BENCH_ADD,      /**< ECDSA_Add */
+    BENCH_SUB,      /**< ECDSA_Sub */
+    BENCH_COMPARE,  /**< ECDSA_Compare */
+    BENCH_IS_ZERO,  /**< ECDSA_Is_Zero */
+    BENCH_IS_ONE,   /**< ECDSA_Is_One */
+    BENCH_COPY,     /**< ECDSA_Copy */
+    BENCH_HALF,     /**< ECDSA_Half_Mod, without its Add */
+    BENCH_OPERATIONS
+} Bench_Operation;
+
+static uint32_t Bench_Counts[BENCH_OPERATIONS]; /* Operations since the start of the bench */
+
+/* The verifier under test, built into the bench with its operations counted */
+#define ECDSA_PROBE(Operation) (Bench_Counts[BENCH_##Operation]++)
+#include "ECDSA.c"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define BENCH_ROUNDS 20u /* Verifications timed per vector */
+
+/*
+ * Cycles of the operations on the MKL46Z4 (Cortex-M0+, single-cycle MULS, no 32x32->64 multiply), built with -Os.
+ * Each (uint64_t)x * y of the CIOS inner loops of ECDSA_Mont_Mul is a call to __aeabi_lmul, which builds the
+ * product from 16-bit halves with four MULS: about 40 cycles with the call. The rest of an inner iteration (two
+ * loads, the 64-bit additions with carry, the store, the loop test and the taken branch) takes about 20 more, and
+ * the 8 outer iterations about 300 in all. The word loops of the other operations take 8 to 18 cycles per word;
+ * ECDSA_Compare usually stops at the most significant word.
+ */
+#define BENCH_MAC_CYCLES 60u /* One inner iteration of ECDSA_Mont_Mul */
+#define BENCH_MONT_MUL_CYCLES (2u * ECDSA_P256_WORDS * ECDSA_P256_WORDS * BENCH_MAC_CYCLES + 300u)
+#define BENCH_CORE_CLOCK_HZ MCG_FLL_CLOCK_HIGH_SPEED_HZ /* MCG_CLOCK_PROFILE_HIGH_SPEED, set for the update */
+
+/*
+ * The shortest data line of an update file: an S1 record of 16 data bytes, 2 + 2 + 4 + 32 + 2 characters and CR LF.
+ * The queue fills fastest with it. One character is 10 bits on the line (start, 8 data, stop).
+ */
+#define BENCH_LINE_CHARACTERS 44u
+#define BENCH_CHARACTER_BITS 10u
+#define BENCH_BAUD_RATE 115200u      /* UART0_BAUD_RATE of main.c */
+#define BENCH_BAUD_RATE_FAST 460800u /* Fastest rate considered for UART0 */
+
+/*
+ *@brief Target cost of one verification.
+ */
+typedef struct Bench_Cost
+{
+    uint32_t Steps;        /**< Calls to ECDSA_P256_Verify_Step */
+    uint32_t Start_Muls;   /**< Montgomery multiplications of ECDSA_P256_Verify_Start */
+    uint32_t Step_Muls;    /**< Montgomery multiplications of the heaviest step */
+    uint64_t Start_Cycles; /**< Cycles of ECDSA_P256_Verify_Start */
+    uint64_t Step_Cycles;  /**< Cycles of the heaviest step */
+} Bench_Cost;
+
+/*
+ *@brief Reference vector.
+ */
+typedef struct Bench_Vector
+{
+    const char *Message;                          /**< Signed message, NULL if only the digest is given */
+    uint8_t Digest[ECDSA_P256_DIGEST_SIZE];       /**< SHA-256 of the message */
+    uint8_t Signature[ECDSA_P256_SIGNATURE_SIZE]; /**< r || s, big-endian */
+    uint8_t Valid;                                /**< Expected result */
+} Bench_Vector;
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static const uint8_t Public_Key[ECDSA_P256_KEY_SIZE] = SIGNING_KEY_PUBLIC_KEY;
+
+static const uint32_t Bench_Cycles[BENCH_OPERATIONS] = {
+    BENCH_MONT_MUL_CYCLES, /* BENCH_MONT_MUL */
+    140u,                  /* BENCH_ADD */
+    150u,                  /* BENCH_SUB */
+    40u,                   /* BENCH_COMPARE */
+    70u,                   /* BENCH_IS_ZERO */
+    70u,                   /* BENCH_IS_ONE */
+    80u,                   /* BENCH_COPY */
+    130u,                  /* BENCH_HALF */
+};
+
+static const Bench_Vector Vectors[] = {
+    {"abc", /* signed by the key of SIGNING_KEY.h */
+     {0xBA, 0x78, 0x16, 0xBF, 0x8F, 0x01, 0xCF, 0xEA, 0x41, 0x41, 0x40, 0xDE, 0x5D, 0xAE, 0x22, 0x23,
+      0xB0, 0x03, 0x61, 0xA3, 0x96, 0x17, 0x7A, 0x9C, 0xB4, 0x10, 0xFF, 0x61, 0xF2, 0x00, 0x15, 0xAD},
+     {0x90, 0xA0, 0x93, 0x82, 0xED, 0x44, 0x65, 0xD2, 0x7F, 0x0C, 0xE5, 0xFE, 0xAF, 0x9B, 0x55, 0xAD,
+      0x16, 0xA9, 0x28, 0x0B, 0x7F, 0xBB, 0xF5, 0xA2, 0x70, 0x18, 0xA6, 0x53, 0x50, 0x6E, 0xD0, 0x98,
+      0xFE, 0x44, 0xCE, 0xD8, 0xB2, 0x44, 0xAF, 0xC4, 0x7F, 0x85, 0x15, 0xC0, 0x0C, 0x71, 0x35, 0x85,
+      0x04, 0xC4, 0x6E, 0xF7, 0x52, 0x53, 0x90, 0x17, 0x98, 0x44, 0x22, 0x52, 0x27, 0x50, 0x79, 0xC9},
+     1},
+    {"MKL46Z4 bootloader image", /* signed by the key of SIGNING_KEY.h */
+     {0x39, 0x36, 0x7E, 0x96, 0xD1, 0x29, 0x71, 0x52, 0x11, 0xFD, 0x5F, 0x27, 0xC3, 0x4E, 0xA6, 0x4C,
+      0x8A, 0x02, 0x7C, 0xD1, 0xBA, 0x66, 0x42, 0x95, 0x6E, 0x32, 0xBB, 0x44, 0x6F, 0x39, 0x99, 0xEA},
+     {0x3F, 0x16, 0x6E, 0x62, 0x3A, 0x8C, 0x61, 0xB4, 0xB1, 0xFE, 0x05, 0x33, 0x56, 0xB3, 0xE7, 0x98,
+      0x7B, 0x50, 0xFB, 0xFB, 0xA9, 0xE9, 0x48, 0xA0, 0xE9, 0x86, 0x50, 0xF2, 0x1A, 0xFB, 0xFB, 0x0A,
+      0x3A, 0x17, 0xB5, 0xDF, 0x54, 0xE9, 0x0E, 0xBA, 0x7B, 0x02, 0x5E, 0x79, 0xA4, 0x17, 0xCB, 0x40,
+      0xCC, 0xF8, 0x1A, 0xEB, 0x7A, 0x3E, 0xE2, 0x75, 0x43, 0xEF, 0xD4, 0x28, 0xB1, 0xE2, 0x5F, 0x74},
+     1},
+    {"", /* signed by the key of SIGNING_KEY.h */
+     {0xE3, 0xB0, 0xC4, 0x42, 0x98, 0xFC, 0x1C, 0x14, 0x9A, 0xFB, 0xF4, 0xC8, 0x99, 0x6F, 0xB9, 0x24,
+      0x27, 0xAE, 0x41, 0xE4, 0x64, 0x9B, 0x93, 0x4C, 0xA4, 0x95, 0x99, 0x1B, 0x78, 0x52, 0xB8, 0x55},
+     {0x06, 0x86, 0x0A, 0x71, 0x7F, 0x9A, 0xD6, 0xB0, 0x3A, 0xCF, 0x22, 0xC4, 0xBA, 0x05, 0xE4, 0xDB,
+      0x5B, 0x6A, 0x3B, 0xAF, 0xB7, 0xF7, 0x2E, 0x96, 0x44, 0xD7, 0x01, 0xE7, 0xFA, 0x65, 0x36, 0xE9,
+      0x96, 0x36, 0x12, 0x8A, 0xC0, 0x3E, 0x21, 0x8A, 0x85, 0x86, 0x1A, 0x29, 0xF7, 0x1A, 0x45, 0x73,
+      0x26, 0x59, 0x84, 0x3E, 0xDA, 0xD4, 0x2F, 0x24, 0x7A, 0xDB, 0xD9, 0x71, 0x25, 0xBC, 0xE5, 0xB8},
+     1},
+    {"abc", /* n - s, the other valid s */
+     {0xBA, 0x78, 0x16, 0xBF, 0x8F, 0x01, 0xCF, 0xEA, 0x41, 0x41, 0x40, 0xDE, 0x5D, 0xAE, 0x22, 0x23,
+      0xB0, 0x03, 0x61, 0xA3, 0x96, 0x17, 0x7A, 0x9C, 0xB4, 0x10, 0xFF, 0x61, 0xF2, 0x00, 0x15, 0xAD},
+     {0x90, 0xA0, 0x93, 0x82, 0xED, 0x44, 0x65, 0xD2, 0x7F, 0x0C, 0xE5, 0xFE, 0xAF, 0x9B, 0x55, 0xAD,
+      0x16, 0xA9, 0x28, 0x0B, 0x7F, 0xBB, 0xF5, 0xA2, 0x70, 0x18, 0xA6, 0x53, 0x50, 0x6E, 0xD0, 0x98,
+      0x01, 0xBB, 0x31, 0x26, 0x4D, 0xBB, 0x50, 0x3C, 0x80, 0x7A, 0xEA, 0x3F, 0xF3, 0x8E, 0xCA, 0x7A,
+      0xB8, 0x22, 0x8B, 0xB6, 0x54, 0xC4, 0x0E, 0x6D, 0x5B, 0x75, 0xA8, 0x70, 0xD5, 0x12, 0xAB, 0x88},
+     1},
+    {NULL, /* digest changed */
+     {0xBA, 0x78, 0x16, 0xBF, 0x8F, 0x01, 0xCF, 0xEA, 0x41, 0x41, 0x40, 0xDE, 0x5D, 0xAE, 0x22, 0x23,
+      0xB0, 0x03, 0x61, 0xA3, 0x96, 0x17, 0x7A, 0x9C, 0xB4, 0x10, 0xFF, 0x61, 0xF2, 0x00, 0x15, 0xAC},
+     {0x90, 0xA0, 0x93, 0x82, 0xED, 0x44, 0x65, 0xD2, 0x7F, 0x0C, 0xE5, 0xFE, 0xAF, 0x9B, 0x55, 0xAD,
+      0x16, 0xA9, 0x28, 0x0B, 0x7F, 0xBB, 0xF5, 0xA2, 0x70, 0x18, 0xA6, 0x53, 0x50, 0x6E, 0xD0, 0x98,
+      0xFE, 0x44, 0xCE, 0xD8, 0xB2, 0x44, 0xAF, 0xC4, 0x7F, 0x85, 0x15, 0xC0, 0x0C, 0x71, 0x35, 0x85,
+      0x04, 0xC4, 0x6E, 0xF7, 0x52, 0x53, 0x90, 0x17, 0x98, 0x44, 0x22, 0x52, 0x27, 0x50, 0x79, 0xC9},
+     0},
+    {NULL, /* r changed */
+     {0xBA, 0x78, 0x16, 0xBF, 0x8F, 0x01, 0xCF, 0xEA, 0x41, 0x41, 0x40, 0xDE, 0x5D, 0xAE, 0x22, 0x23,
+      0xB0, 0x03, 0x61, 0xA3, 0x96, 0x17, 0x7A, 0x9C, 0xB4, 0x10, 0xFF, 0x61, 0xF2, 0x00, 0x15, 0xAD},
+     {0x90, 0xA0, 0x93, 0x82, 0xED, 0x44, 0x65, 0xD2, 0x7F, 0x0C, 0xE5, 0xFE, 0xAF, 0x9B, 0x55, 0xAD,
+      0x16, 0xA9, 0x28, 0x0B, 0x7F, 0xBB, 0xF5, 0xA2, 0x70, 0x18, 0xA6, 0x53, 0x50, 0x6E, 0xD0, 0xB8,
+      0xFE, 0x44, 0xCE, 0xD8, 0xB2, 0x44, 0xAF, 0xC4, 0x7F, 0x85, 0x15, 0xC0, 0x0C, 0x71, 0x35, 0x85,
+      0x04, 0xC4, 0x6E, 0xF7, 0x52, 0x53, 0x90, 0x17, 0x98, 0x44, 0x22, 0x52, 0x27, 0x50, 0x79, 0xC9},
+     0},
+    {NULL, /* s changed */
+     {0xBA, 0x78, 0x16, 0xBF, 0x8F, 0x01, 0xCF, 0xEA, 0x41, 0x41, 0x40, 0xDE, 0x5D, 0xAE, 0x22, 0x23,
+      0xB0, 0x03, 0x61, 0xA3, 0x96, 0x17, 0x7A, 0x9C, 0xB4, 0x10, 0xFF, 0x61, 0xF2, 0x00, 0x15, 0xAD},
+     {0x90, 0xA0, 0x93, 0x82, 0xED, 0x44, 0x65, 0xD2, 0x7F, 0x0C, 0xE5, 0xFE, 0xAF, 0x9B, 0x55, 0xAD,
+      0x16, 0xA9, 0x28, 0x0B, 0x7F, 0xBB, 0xF5, 0xA2, 0x70, 0x18, 0xA6, 0x53, 0x50, 0x6E, 0xD0, 0x98,
+      0xFE, 0x44, 0xCE, 0xD8, 0xB2, 0x44, 0xAE, 0xC4, 0x7F, 0x85, 0x15, 0xC0, 0x0C, 0x71, 0x35, 0x85,
+      0x04, 0xC4, 0x6E, 0xF7, 0x52, 0x53, 0x90, 0x17, 0x98, 0x44, 0x22, 0x52, 0x27, 0x50, 0x79, 0xC9},
+     0},
+    {NULL, /* r = 0 */
+     {0xBA, 0x78, 0x16, 0xBF, 0x8F, 0x01, 0xCF, 0xEA, 0x41, 0x41, 0x40, 0xDE, 0x5D, 0xAE, 0x22, 0x23,
+      0xB0, 0x03, 0x61, 0xA3, 0x96, 0x17, 0x7A, 0x9C, 0xB4, 0x10, 0xFF, 0x61, 0xF2, 0x00, 0x15, 0xAD},
+     {0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0xFE, 0x44, 0xCE, 0xD8, 0xB2, 0x44, 0xAF, 0xC4, 0x7F, 0x85, 0x15, 0xC0, 0x0C, 0x71, 0x35, 0x85,
+      0x04, 0xC4, 0x6E, 0xF7, 0x52, 0x53, 0x90, 0x17, 0x98, 0x44, 0x22, 0x52, 0x27, 0x50, 0x79, 0xC9},
+     0},
+    {NULL, /* s = 0 */
+     {0xBA, 0x78, 0x16, 0xBF, 0x8F, 0x01, 0xCF, 0xEA, 0x41, 0x41, 0x40, 0xDE, 0x5D, 0xAE, 0x22, 0x23,
+      0xB0, 0x03, 0x61, 0xA3, 0x96, 0x17, 0x7A, 0x9C, 0xB4, 0x10, 0xFF, 0x61, 0xF2, 0x00, 0x15, 0xAD},
+     {0x90, 0xA0, 0x93, 0x82, 0xED, 0x44, 0x65, 0xD2, 0x7F, 0x0C, 0xE5, 0xFE, 0xAF, 0x9B, 0x55, 0xAD,
+      0x16, 0xA9, 0x28, 0x0B, 0x7F, 0xBB, 0xF5, 0xA2, 0x70, 0x18, 0xA6, 0x53, 0x50, 0x6E, 0xD0, 0x98,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+      0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00},
+     0},
+    {NULL, /* r = n */
+     {0xBA, 0x78, 0x16, 0xBF, 0x8F, 0x01, 0xCF, 0xEA, 0x41, 0x41, 0x40, 0xDE, 0x5D, 0xAE, 0x22, 0x23,
+      0xB0, 0x03, 0x61, 0xA3, 0x96, 0x17, 0x7A, 0x9C, 0xB4, 0x10, 0xFF, 0x61, 0xF2, 0x00, 0x15, 0xAD},
+     {0xFF, 0xFF, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+      0xBC, 0xE6, 0xFA, 0xAD, 0xA7, 0x17, 0x9E, 0x84, 0xF3, 0xB9, 0xCA, 0xC2, 0xFC, 0x63, 0x25, 0x51,
+      0xFE, 0x44, 0xCE, 0xD8, 0xB2, 0x44, 0xAF, 0xC4, 0x7F, 0x85, 0x15, 0xC0, 0x0C, 0x71, 0x35, 0x85,
+      0x04, 0xC4, 0x6E, 0xF7, 0x52, 0x53, 0x90, 0x17, 0x98, 0x44, 0x22, 0x52, 0x27, 0x50, 0x79, 0xC9},
+     0},
+};
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *@brief Target cycles of the operations counted so far.
+ */
+static uint64_t Target_Cycles(void)
+{
+    uint64_t cycles = 0;
+    uint8_t i = 0;
+
+    for (i = 0; i < BENCH_OPERATIONS; i++)
+    {
+        cycles += (uint64_t)Bench_Counts[i] * Bench_Cycles[i];
+    }
+
+    return cycles;
+}
+
+/*
+ *@brief Verifies a signature step by step.
+ *@param Vector The vector to verify.
+ *@param Cost Receives the target cost of the verification.
+ *@returns ECDSA_VALID or ECDSA_INVALID.
+ */
+static ECDSA_Status Verify(const Bench_Vector *Vector, Bench_Cost *Cost)
+{
+    ECDSA_P256_Context context;
+    ECDSA_Status status = ECDSA_BUSY;
+    uint64_t cycles = 0;
+    uint32_t muls = 0;
+
+    memset(Cost, 0, sizeof(*Cost));
+    cycles = Target_Cycles();
+    muls = Bench_Counts[BENCH_MONT_MUL];
+    ECDSA_P256_Verify_Start(&context, Public_Key, Vector->Digest, Vector->Signature);
+    Cost->Start_Cycles = Target_Cycles() - cycles;
+    Cost->Start_Muls = Bench_Counts[BENCH_MONT_MUL] - muls;
+    status = context.Status;
+    while (ECDSA_BUSY == status)
+    {
+        cycles = Target_Cycles();
+        muls = Bench_Counts[BENCH_MONT_MUL];
+        status = ECDSA_P256_Verify_Step(&context);
+        if (Cost->Step_Cycles < Target_Cycles() - cycles)
+        {
+            Cost->Step_Cycles = Target_Cycles() - cycles;
+            Cost->Step_Muls = Bench_Counts[BENCH_MONT_MUL] - muls;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        Cost->Steps++;
+    }
+
+    return status;
+}
+
+/*
+ *@brief Converts target cycles to milliseconds at the update session clock.
+ */
+static double Target_Ms(double Cycles)
+{
+    return Cycles * 1000.0 / BENCH_CORE_CLOCK_HZ;
+}
+
+/*
+ *@brief Time UART0 takes to fill the record queue with the shortest data lines, in milliseconds.
+ */
+static double Queue_Fill_Ms(uint32_t Baud_Rate)
+{
+    return (double)NUMBER_OF_QUEUES * BENCH_LINE_CHARACTERS * BENCH_CHARACTER_BITS * 1000.0 / Baud_Rate;
+}
+
+int main(void)
+{
+    uint32_t failures = 0;
+    uint32_t i = 0;
+    uint32_t round = 0;
+    uint8_t digest[SHA256_DIGEST_SIZE];
+    SHA256_Context hash;
+    ECDSA_Status status = ECDSA_IDLE;
+    Bench_Cost cost;
+    Bench_Cost worst = {0};
+    clock_t start = 0;
+    double seconds = 0;
+    double longest_ms = 0;
+
+    for (i = 0; i < sizeof(Vectors) / sizeof(Vectors[0]); i++)
+    {
+        if (NULL != Vectors[i].Message)
+        {
+            SHA256_Init(&hash);
+            SHA256_Update(&hash, (const uint8_t *)Vectors[i].Message, (uint32_t)strlen(Vectors[i].Message));
+            SHA256_Final(&hash, digest);
+            if (0 != memcmp(digest, Vectors[i].Digest, SHA256_DIGEST_SIZE))
+            {
+                printf("FAIL vector %u: SHA-256 of \"%s\"\n", (unsigned)i, Vectors[i].Message);
+                failures++;
+            }
+            else
+            {
+                /* Do nothing */
+            }
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        start = clock();
+        for (round = 0; round < BENCH_ROUNDS; round++)
+        {
+            status = Verify(&Vectors[i], &cost);
+        }
+        seconds = (double)(clock() - start) / CLOCKS_PER_SEC / BENCH_ROUNDS;
+        if ((ECDSA_VALID == status) != (0 != Vectors[i].Valid))
+        {
+            printf("FAIL vector %u: %s\n", (unsigned)i, (ECDSA_VALID == status) ? "accepted" : "rejected");
+            failures++;
+        }
+        else
+        {
+            printf("vector %u: %s, %u steps, %.2f ms on the host\n", (unsigned)i,
+                   (ECDSA_VALID == status) ? "valid" : "invalid", (unsigned)cost.Steps, seconds * 1000.0);
+        }
+        if (worst.Start_Cycles < cost.Start_Cycles)
+        {
+            worst.Start_Cycles = cost.Start_Cycles;
+            worst.Start_Muls = cost.Start_Muls;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+        if (worst.Step_Cycles < cost.Step_Cycles)
+        {
+            worst.Step_Cycles = cost.Step_Cycles;
+            worst.Step_Muls = cost.Step_Muls;
+        }
+        else
+        {
+            /* Do nothing */
+        }
+    }
+
+    printf("ECDSA P-256 on the target at %.2f MHz, %u cycles per Montgomery multiplication:\n",
+           BENCH_CORE_CLOCK_HZ / 1e6, (unsigned)BENCH_MONT_MUL_CYCLES);
+    printf("  start: %u multiplications and the inverse of s, %.2f ms\n", (unsigned)worst.Start_Muls,
+           Target_Ms((double)worst.Start_Cycles));
+    printf("  heaviest step: %u multiplications, %.2f ms\n", (unsigned)worst.Step_Muls,
+           Target_Ms((double)worst.Step_Cycles));
+    printf("  record queue, %u lines of %u characters: %.2f ms at %u baud, %.2f ms at %u baud\n",
+           (unsigned)NUMBER_OF_QUEUES, (unsigned)BENCH_LINE_CHARACTERS, Queue_Fill_Ms(BENCH_BAUD_RATE),
+           (unsigned)BENCH_BAUD_RATE, Queue_Fill_Ms(BENCH_BAUD_RATE_FAST), (unsigned)BENCH_BAUD_RATE_FAST);
+    longest_ms = Target_Ms((double)((worst.Start_Cycles > worst.Step_Cycles) ? worst.Start_Cycles : worst.Step_Cycles));
+    if (longest_ms >= Queue_Fill_Ms(BENCH_BAUD_RATE))
+    {
+        printf("FAIL: longer than the record queue at %u baud\n", (unsigned)BENCH_BAUD_RATE);
+        failures++;
+    }
+    else if (longest_ms >= Queue_Fill_Ms(BENCH_BAUD_RATE_FAST))
+    {
+        printf("  longer than the record queue at %u baud\n", (unsigned)BENCH_BAUD_RATE_FAST);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+    printf("ECDSA P-256: vectors %s\n", (0 == failures) ? "ok" : "FAILED");
+
+    return (0 == failures) ? 0 : 1;
+}
+
+/* EOF */
@@ -0,0 +1,172 @@
+/**
+ * @file frame_check.c
+ * @brief Host check of the binary frame reception.
+ * @details This program builds Sources/FRAME.c for the host with a signed char, as the reception must work whatever
+ *          the signedness of char, and sends frames through the path of the UART0 interrupt: every received byte goes
+ *          through FRAME_Collect into a queue element, and each completed frame is decoded with FRAME_Parse as the
+ *          update loop does. The wire carries text and noise between frames, a frame with a corrupted length, a frame
+ *          with a corrupted CRC, and payloads of every length with bytes above 0x7F.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "FRAME.h"
+#include "QUEUE.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define CHECK_WIRE_SIZE 16384u
+#define CHECK_MAX_FRAMES 128u
+#define CHECK_ADDRESS 0x0000A000u
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint8_t wire[CHECK_WIRE_SIZE]; /* Bytes sent by the host */
+static uint32_t wire_length = 0;
+static uint8_t expected_length[CHECK_MAX_FRAMES]; /* Payload length of each intact frame sent */
+static uint32_t expected_frames = 0;
+static volatile Queue element;
+static volatile uint8_t buffer_index = 0;
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *@brief Returns payload byte i of the frame with the given sequence number.
+ */
+static uint8_t Payload_Byte(uint8_t Sequence, uint8_t i)
+{
+    return (uint8_t)(0x80u + Sequence * 7u + i); /* Above 0x7F, negative as a signed char */
+}
+
+/*
+ *@brief Appends bytes to the wire.
+ */
+static void Send(const uint8_t *Data, uint32_t Length)
+{
+    memcpy(&wire[wire_length], Data, Length);
+    wire_length += Length;
+}
+
+/*
+ *@brief Appends a frame to the wire.
+ *@param Sequence The sequence number, which also selects the payload.
+ *@param Length Number of payload bytes.
+ *@param Corrupt 1 to flip a payload bit after the CRC is computed.
+ */
+static void Send_Frame(uint8_t Sequence, uint8_t Length, uint8_t Corrupt)
+{
+    char frame[MAX_LINE_LENGTH_RECORD];
+    uint8_t payload[FRAME_MAX_PAYLOAD];
+    uint8_t i = 0;
+
+    for (i = 0; i < Length; i++)
+    {
+        payload[i] = Payload_Byte(Sequence, i);
+    }
+    FRAME_Build(frame, '1', Sequence, CHECK_ADDRESS + Sequence * FRAME_MAX_PAYLOAD, payload, Length);
+    if (Corrupt)
+    {
+        frame[FRAME_HEADER_SIZE] ^= 0x01;
+    }
+    else
+    {
+        expected_length[expected_frames++] = Length;
+    }
+    Send((const uint8_t *)frame, FRAME_HEADER_SIZE + Length + FRAME_CRC_SIZE);
+}
+
+/*
+ *@brief Checks a completed frame against the one sent.
+ *@returns 1 if it matches.
+ */
+static uint8_t Check_Frame(uint32_t Number)
+{
+    Record record_struct;
+    uint8_t data[FRAME_MAX_PAYLOAD];
+    uint8_t sequence = (uint8_t)element.record[FRAME_SEQUENCE_INDEX];
+    uint8_t byte_count = 0;
+    uint8_t result = 0;
+    uint8_t i = 0;
+
+    if (FRAME_SYNC == (uint8_t)element.record[0]) /* As the update loop tells frames from S-records */
+    {
+        byte_count = FRAME_Parse(element.record, &record_struct, data);
+    }
+    if (Number < expected_frames && expected_length[Number] + FRAME_RECORD_OVERHEAD == byte_count &&
+        CHECK_ADDRESS + sequence * FRAME_MAX_PAYLOAD == record_struct.address)
+    {
+        result = 1;
+        for (i = 0; i < expected_length[Number]; i++)
+        {
+            if (Payload_Byte(sequence, i) != data[i])
+            {
+                result = 0;
+            }
+        }
+    }
+
+    return result;
+}
+
+int main(void)
+{
+    static const uint8_t text[] = " Please update SREC (file format) now !\r\n";
+    static const uint8_t bad_length[] = {FRAME_SYNC, '1', 0x40, FRAME_MAX_PAYLOAD + 1u, 0x00};
+    uint32_t failures = 0;
+    uint32_t received = 0;
+    uint32_t corrupted = 0;
+    uint32_t i = 0;
+    uint8_t sequence = 0;
+
+    Send(text, sizeof(text) - 1u); /* Bytes outside a frame are dropped */
+    for (i = 0; i <= FRAME_MAX_PAYLOAD; i++)
+    {
+        Send_Frame(sequence++, (uint8_t)i, 0);
+    }
+    Send(bad_length, sizeof(bad_length)); /* Dropped at the length byte */
+    Send_Frame(sequence++, 16, 0);
+    Send_Frame(sequence++, 16, 1); /* Collected, refused by FRAME_Parse */
+    Send_Frame(sequence++, FRAME_MAX_PAYLOAD, 0);
+
+    for (i = 0; i < wire_length; i++)
+    {
+        if (FRAME_Collect(element.record, &buffer_index, wire[i])) /* As the UART0 interrupt */
+        {
+            if (Check_Frame(received))
+            {
+                received++;
+            }
+            else if (FRAME_SYNC == (uint8_t)element.record[0] && !FRAME_Check(element.record))
+            {
+                corrupted++;
+            }
+            else
+            {
+                printf("FAIL frame %u not received as sent\n", (unsigned)received);
+                failures++;
+            }
+        }
+    }
+    if (expected_frames != received || 1u != corrupted || 0 != buffer_index)
+    {
+        printf("FAIL %u of %u frames received, %u corrupted\n", (unsigned)received, (unsigned)expected_frames,
+               (unsigned)corrupted);
+        failures++;
+    }
+    printf("Frames: %s, %u received, %u refused\n", (0 == failures) ? "ok" : "FAILED", (unsigned)received,
+           (unsigned)corrupted);
+
+    return (0 == failures) ? 0 : 1;
+}
+
+/* EOF */
@@ -0,0 +1,153 @@
+/**
+ * @file patch_gen.c
+ * @brief Host delta patch generator.
+ * @details This program builds the delta patch rebuilding a new application image from the installed one, and the
+ *          S0 records that announce it in the update stream:
+ *
+ *              patch_gen <old.bin> <new.bin> <patch.bin> <load address> [version]
+ *
+ *          The images are raw binaries of the application slot (objcopy -O binary); the new one must be linked for
+ *          the slot it is sent to, whose address is the load address. The program writes the patch and prints the
+ *          patch record (IMAGE_RECORD_TAG_PATCH), to be sent first, and the image header record, to be sent next. The
+ *          raw patch bytes follow once the bootloader answers "Send the patch now", then the S9 record.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include <stdlib.h>
+#include "patch_generate.h"
+#include "CRC32.h"
+#include "IMAGE.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define PATCH_GEN_RECORD_DATA 16u /* Data bytes of the patch and header records */
+#define PATCH_GEN_MIN_LENGTH 8u   /* Initial MSP and reset vector, as IMAGE.c requires */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint8_t old_image[IMAGE_SLOT_SIZE];
+static uint8_t new_image[IMAGE_SLOT_SIZE];
+static uint8_t patch[2u * IMAGE_SLOT_SIZE];
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *@brief Reads a whole image file.
+ *@returns Length of the image; 0 if it cannot be read or does not fit in a slot.
+ */
+static uint32_t Read_Image(const char *Path, uint8_t *Image)
+{
+    FILE *file = fopen(Path, "rb");
+    uint32_t length = 0;
+
+    if (NULL != file)
+    {
+        length = (uint32_t)fread(Image, 1, IMAGE_SLOT_SIZE, file);
+        if (0 == feof(file) && EOF != fgetc(file))
+        {
+            length = 0; /* Larger than a slot */
+        }
+        fclose(file);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    return length;
+}
+
+/*
+ *@brief Stores a 32-bit value big-endian, as IMAGE_Bytes_To_Word reads it.
+ */
+static void Put_Word(uint8_t *Data, uint32_t Value)
+{
+    Data[0] = (uint8_t)(Value >> 24);
+    Data[1] = (uint8_t)(Value >> 16);
+    Data[2] = (uint8_t)(Value >> 8);
+    Data[3] = (uint8_t)Value;
+}
+
+/*
+ *@brief Prints an S0 record with a 16-bit tag in the address field.
+ */
+static void Print_S0(uint16_t Tag, const uint8_t *Data, uint8_t Length)
+{
+    uint8_t count = (uint8_t)(Length + 3u); /* Address and checksum */
+    uint8_t sum = (uint8_t)(count + (Tag >> 8) + Tag);
+    uint8_t i = 0;
+
+    printf("S0%02X%04X", count, Tag);
+    for (i = 0; i < Length; i++)
+    {
+        printf("%02X", Data[i]);
+        sum = (uint8_t)(sum + Data[i]);
+    }
+    printf("%02X\n", (uint8_t)~sum);
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t old_length = 0;
+    uint32_t new_length = 0;
+    uint32_t patch_length = 0;
+    uint32_t load_address = 0;
+    uint8_t record[PATCH_GEN_RECORD_DATA];
+    FILE *file = NULL;
+    int result = 1;
+
+    if (5 > argc)
+    {
+        fprintf(stderr, "usage: patch_gen <old.bin> <new.bin> <patch.bin> <load address> [version]\n");
+        return 2;
+    }
+    old_length = Read_Image(argv[1], old_image);
+    new_length = Read_Image(argv[2], new_image);
+    load_address = (uint32_t)strtoul(argv[4], NULL, 0);
+    if (0 == old_length || PATCH_GEN_MIN_LENGTH > new_length)
+    {
+        fprintf(stderr, "patch_gen: images missing, empty or larger than a slot (%u bytes)\n", (unsigned)IMAGE_SLOT_SIZE);
+    }
+    else
+    {
+        patch_length = Patch_Generate(old_image, old_length, new_image, new_length, patch, sizeof(patch));
+        file = fopen(argv[3], "wb");
+        if (0 == patch_length || NULL == file || patch_length != fwrite(patch, 1, patch_length, file))
+        {
+            fprintf(stderr, "patch_gen: cannot write %s\n", argv[3]);
+        }
+        else
+        {
+            Put_Word(&record[0], patch_length);
+            Put_Word(&record[4], old_length);
+            Put_Word(&record[8], CRC32_Compute(old_image, old_length));
+            Put_Word(&record[12], 0); /* Sector count, ignored */
+            Print_S0(IMAGE_RECORD_TAG_PATCH, record, PATCH_GEN_RECORD_DATA);
+            Put_Word(&record[0], new_length);
+            Put_Word(&record[4], load_address);
+            Put_Word(&record[8], (6 > argc) ? 0u : (uint32_t)strtoul(argv[5], NULL, 0));
+            Put_Word(&record[12], CRC32_Compute(new_image, new_length));
+            Print_S0(IMAGE_RECORD_TAG_HEADER, record, PATCH_GEN_RECORD_DATA);
+            fprintf(stderr, "patch_gen: %u byte image, %u byte patch\n", (unsigned)new_length, (unsigned)patch_length);
+            result = 0;
+        }
+        if (NULL != file)
+        {
+            fclose(file);
+        }
+    }
+
+    return result;
+}
+
+/* EOF */
@@ -0,0 +1,214 @@
+/**
+ * @file patch_generate.c
+ * @brief Host delta patch generator.
+ * @details This file contains the generator of the delta patches decoded by Sources/PATCH.c. Every position of the old
+ *          image is chained in a hash table by its first PATCH_GENERATE_SEED bytes. For each position of the new image
+ *          the continuation of the previous copy is tried first, then up to PATCH_GENERATE_CANDIDATES old positions
+ *          with the same hash; the longest match of at least PATCH_GENERATE_SEED bytes becomes a copy. Bytes with no
+ *          such match are gathered into inserts.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "patch_generate.h"
+#include "PATCH.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define PATCH_GENERATE_HASH_BITS 16u
+#define PATCH_GENERATE_NONE 0xFFFFFFFFu /* End of a hash chain */
+
+/*
+ *@brief Patch being written.
+ */
+typedef struct Patch_Writer
+{
+    uint8_t *Data;     /**< Patch buffer */
+    uint32_t Size;     /**< Size of the buffer */
+    uint32_t Length;   /**< Bytes written */
+    uint8_t Overflow;  /**< 1 once a byte did not fit */
+} Patch_Writer;
+
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *@brief Appends one byte to the patch.
+ */
+static void Patch_Put(Patch_Writer *Writer, uint8_t Data)
+{
+    if (Writer->Length < Writer->Size)
+    {
+        Writer->Data[Writer->Length++] = Data;
+    }
+    else
+    {
+        Writer->Overflow = 1;
+    }
+}
+
+/*
+ *@brief Appends a LEB128 varint to the patch.
+ */
+static void Patch_Put_Varint(Patch_Writer *Writer, uint32_t Value)
+{
+    while (0x7Fu < Value)
+    {
+        Patch_Put(Writer, (uint8_t)(0x80u | (Value & 0x7Fu)));
+        Value >>= 7;
+    }
+    Patch_Put(Writer, (uint8_t)Value);
+}
+
+/*
+ *@brief Appends an insert of the given new bytes, if any.
+ */
+static void Patch_Put_Insert(Patch_Writer *Writer, const uint8_t *Data, uint32_t Length)
+{
+    uint32_t i = 0;
+
+    if (0u != Length)
+    {
+        Patch_Put(Writer, PATCH_OP_INSERT);
+        Patch_Put_Varint(Writer, Length);
+        for (i = 0; i < Length; i++)
+        {
+            Patch_Put(Writer, Data[i]);
+        }
+    }
+    else
+    {
+        /* Do nothing */
+    }
+}
+
+/*
+ *@brief Hashes the PATCH_GENERATE_SEED bytes at Data.
+ */
+static uint32_t Patch_Hash(const uint8_t *Data)
+{
+    uint32_t hash = 2166136261u; /* FNV-1a */
+    uint32_t i = 0;
+
+    for (i = 0; i < PATCH_GENERATE_SEED; i++)
+    {
+        hash = (hash ^ Data[i]) * 16777619u;
+    }
+
+    return hash >> (32u - PATCH_GENERATE_HASH_BITS);
+}
+
+/*
+ *@brief Returns the number of equal bytes from Old[Old_Offset] and New[New_Offset].
+ */
+static uint32_t Patch_Match(const uint8_t *Old, uint32_t Old_Length, uint32_t Old_Offset, const uint8_t *New,
+                            uint32_t New_Length, uint32_t New_Offset)
+{
+    uint32_t length = 0;
+
+    while (Old_Offset + length < Old_Length && New_Offset + length < New_Length &&
+           Old[Old_Offset + length] == New[New_Offset + length])
+    {
+        length++;
+    }
+
+    return length;
+}
+
+/*
+ *@brief Builds the patch rebuilding New from Old.
+ *@param Old Pointer to the old image.
+ *@param Old_Length Length of the old image.
+ *@param New Pointer to the new image.
+ *@param New_Length Length of the new image.
+ *@param Patch Pointer to the buffer receiving the patch.
+ *@param Patch_Size Size of the buffer.
+ *@returns Length of the patch; 0 if it does not fit in the buffer.
+ */
+uint32_t Patch_Generate(const uint8_t *Old, uint32_t Old_Length, const uint8_t *New, uint32_t New_Length,
+                        uint8_t *Patch, uint32_t Patch_Size)
+{
+    Patch_Writer writer = {Patch, Patch_Size, 0, 0};
+    uint32_t *head = malloc(sizeof(uint32_t) << PATCH_GENERATE_HASH_BITS);
+    uint32_t *next = malloc(sizeof(uint32_t) * (Old_Length + 1u));
+    uint32_t position = 0;
+    uint32_t literal = 0;     /* First new byte not yet in the patch */
+    uint32_t next_old = PATCH_GENERATE_NONE; /* Old offset continuing the previous copy */
+    uint32_t best_length = 0;
+    uint32_t best_offset = 0;
+    uint32_t candidate = 0;
+    uint32_t tries = 0;
+    uint32_t length = 0;
+
+    memset(head, 0xFF, sizeof(uint32_t) << PATCH_GENERATE_HASH_BITS);
+    for (position = Old_Length; PATCH_GENERATE_SEED <= position; position--)
+    {
+        /* Chained from the end, so the lowest offsets are tried first */
+        candidate = Patch_Hash(&Old[position - PATCH_GENERATE_SEED]);
+        next[position - PATCH_GENERATE_SEED] = head[candidate];
+        head[candidate] = position - PATCH_GENERATE_SEED;
+    }
+
+    Patch_Put(&writer, (uint8_t)PATCH_MAGIC);
+    Patch_Put(&writer, (uint8_t)(PATCH_MAGIC >> 8));
+    Patch_Put(&writer, (uint8_t)(PATCH_MAGIC >> 16));
+    Patch_Put(&writer, (uint8_t)(PATCH_MAGIC >> 24));
+
+    position = 0;
+    while (position < New_Length)
+    {
+        best_length = 0;
+        if (PATCH_GENERATE_NONE != next_old)
+        {
+            best_length = Patch_Match(Old, Old_Length, next_old, New, New_Length, position);
+            best_offset = next_old;
+        }
+        if (PATCH_GENERATE_SEED > best_length && position + PATCH_GENERATE_SEED <= New_Length)
+        {
+            candidate = head[Patch_Hash(&New[position])];
+            for (tries = 0; PATCH_GENERATE_NONE != candidate && PATCH_GENERATE_CANDIDATES > tries; tries++)
+            {
+                length = Patch_Match(Old, Old_Length, candidate, New, New_Length, position);
+                if (best_length < length)
+                {
+                    best_length = length;
+                    best_offset = candidate;
+                }
+                candidate = next[candidate];
+            }
+        }
+        if (PATCH_GENERATE_SEED <= best_length)
+        {
+            Patch_Put_Insert(&writer, &New[literal], position - literal);
+            Patch_Put(&writer, PATCH_OP_COPY);
+            Patch_Put_Varint(&writer, best_offset);
+            Patch_Put_Varint(&writer, best_length);
+            position += best_length;
+            literal = position;
+            next_old = best_offset + best_length;
+        }
+        else
+        {
+            position++;
+            next_old = (PATCH_GENERATE_NONE != next_old) ? next_old + 1u : PATCH_GENERATE_NONE; /* Changed byte in a copied run */
+        }
+    }
+    Patch_Put_Insert(&writer, &New[literal], New_Length - literal);
+    Patch_Put(&writer, PATCH_OP_END);
+
+    free(head);
+    free(next);
+
+    return (0u == writer.Overflow) ? writer.Length : 0u;
+}
+
+/* EOF */
@@ -0,0 +1,45 @@
+/**
+ * @file patch_generate.h
+ * @brief Header file for the host delta patch generator.
+ * @details This header file declares the generator of the delta patches decoded by Sources/PATCH.c, shared by
+ *          patch_gen and patch_sim. The new image is matched greedily against the old one through a hash of every
+ *          PATCH_GENERATE_SEED bytes of the old image; runs matching at least that long become copies, the rest
+ *          inserts.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+#ifndef TOOLS_PATCH_GENERATE_H_
+#define TOOLS_PATCH_GENERATE_H_
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdint.h>
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define PATCH_GENERATE_SEED 8u        /* Shortest copy, and bytes hashed to find one */
+#define PATCH_GENERATE_CANDIDATES 64u /* Old positions tried per new position */
+
+/*******************************************************************************
+ * Prototypes
+ ******************************************************************************/
+
+/*
+ *@brief Builds the patch rebuilding New from Old.
+ *@param Old Pointer to the old image.
+ *@param Old_Length Length of the old image.
+ *@param New Pointer to the new image.
+ *@param New_Length Length of the new image.
+ *@param Patch Pointer to the buffer receiving the patch.
+ *@param Patch_Size Size of the buffer.
+ *@returns Length of the patch; 0 if it does not fit in the buffer.
+ */
+uint32_t Patch_Generate(const uint8_t *Old, uint32_t Old_Length, const uint8_t *New, uint32_t New_Length,
+                        uint8_t *Patch, uint32_t Patch_Size);
+
+#endif /* TOOLS_PATCH_GENERATE_H_ */
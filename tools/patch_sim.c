@@ -0,0 +1,271 @@
+/**
+ * @file patch_sim.c
+ * @brief Host simulation of delta updates.
+ * @details This program applies delta patches with Sources/PATCH.c the way the update session does: the base image
+ *          stays in the active slot, read through the Read_Old callback, while the new image is programmed from start
+ *          to end into the other slot, erased beforehand. Programming a byte that is not erased fails, as on flash.
+ *
+ *              patch_sim                              built-in updates, patches made by patch_generate.c
+ *              patch_sim <old.bin> <new.bin> <patch.bin>   a patch made by patch_gen
+ *
+ *          Each update checks that the new slot matches the new image and its CRC-32, and that a truncated patch or
+ *          one with a bad magic is refused.
+ *
+ * @author  Nguyen Dang Nhu Tri
+ * @version 1.0
+ * @date    2024/07/19
+ * @copyright Copyright (c) 2024 Nguyen Dang Nhu Tri.
+ */
+
+/*******************************************************************************
+ * Includes
+ ******************************************************************************/
+#include <stdio.h>
+#include <string.h>
+#include "patch_generate.h"
+#include "CRC32.h"
+#include "IMAGE.h"
+#include "PATCH.h"
+/*******************************************************************************
+ * Definitions
+ ******************************************************************************/
+#define SIM_ERASED 0xFFu
+#define SIM_IMAGE_SIZE (96u * 1024u) /* Size of the built-in images, within a slot */
+
+/*******************************************************************************
+ * Variables
+ ******************************************************************************/
+static uint8_t active_slot[IMAGE_SLOT_SIZE];  /* Base image */
+static uint8_t update_slot[IMAGE_SLOT_SIZE];  /* Slot being updated */
+static uint8_t new_image[IMAGE_SLOT_SIZE];
+static uint8_t patch[2u * IMAGE_SLOT_SIZE];
+static uint32_t output_address = 0; /* Next byte programmed, as in main.c */
+static uint8_t output_error = 0;
+static uint32_t random_state = 0x2545F491u;
+/*******************************************************************************
+ * Code
+ ******************************************************************************/
+
+/*
+ *@brief Programs the next byte of the new image into the update slot.
+ */
+static void Sim_Output(uint8_t Data)
+{
+    if (IMAGE_SLOT_SIZE <= output_address || SIM_ERASED != update_slot[output_address])
+    {
+        output_error = 1; /* Past the slot, or programmed twice */
+    }
+    else
+    {
+        update_slot[output_address++] = Data;
+    }
+}
+
+/*
+ *@brief Returns a byte of the base image, as Stream_Read_Old.
+ */
+static uint8_t Sim_Read_Old(uint32_t Offset)
+{
+    return active_slot[Offset];
+}
+
+/*
+ *@brief Applies a patch to the base image.
+ *@returns The status after the last patch byte.
+ */
+static PATCH_Status Sim_Apply(uint32_t Old_Length, const uint8_t *Patch, uint32_t Patch_Length)
+{
+    PATCH_Context patcher;
+    PATCH_Status status = PATCH_BUSY;
+    uint32_t i = 0;
+
+    memset(update_slot, SIM_ERASED, sizeof(update_slot)); /* Prepare_Patch_Slot */
+    output_address = 0;
+    output_error = 0;
+    PATCH_Init(&patcher, Sim_Output, Sim_Read_Old, Old_Length);
+    for (i = 0; i < Patch_Length && PATCH_BUSY == status; i++)
+    {
+        status = PATCH_Decode_Byte(&patcher, Patch[i]);
+    }
+    if (i != Patch_Length || 0 != output_error)
+    {
+        status = PATCH_ERROR; /* Bytes past the end command, as Stream_Decode refuses them */
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    return status;
+}
+
+/*
+ *@brief Applies a patch and checks the result, then checks that a truncated and a corrupted patch are refused.
+ *@returns Number of failures.
+ */
+static uint32_t Sim_Update(const char *Name, uint32_t Old_Length, uint32_t New_Length, uint32_t Patch_Length)
+{
+    uint32_t failures = 0;
+    uint8_t saved = 0;
+
+    if (PATCH_DONE != Sim_Apply(Old_Length, patch, Patch_Length) || New_Length != output_address ||
+        0 != memcmp(update_slot, new_image, New_Length) ||
+        CRC32_Compute(new_image, New_Length) != CRC32_Compute(update_slot, output_address))
+    {
+        printf("FAIL %s: new image not rebuilt\n", Name);
+        failures++;
+    }
+    if (PATCH_DONE == Sim_Apply(Old_Length, patch, Patch_Length - 1u))
+    {
+        printf("FAIL %s: truncated patch accepted\n", Name);
+        failures++;
+    }
+    saved = patch[0];
+    patch[0] ^= 0x01u;
+    if (PATCH_DONE == Sim_Apply(Old_Length, patch, Patch_Length))
+    {
+        printf("FAIL %s: patch with a bad magic accepted\n", Name);
+        failures++;
+    }
+    patch[0] = saved;
+    printf("%s: %u byte image, %u byte patch (%.1f%%)\n", Name, (unsigned)New_Length, (unsigned)Patch_Length,
+           100.0 * Patch_Length / New_Length);
+
+    return failures;
+}
+
+/*
+ *@brief Returns a pseudo-random byte (xorshift32).
+ */
+static uint8_t Sim_Random(void)
+{
+    random_state ^= random_state << 13;
+    random_state ^= random_state >> 17;
+    random_state ^= random_state << 5;
+
+    return (uint8_t)random_state;
+}
+
+/*
+ *@brief Fills Length bytes with code-like data: short runs of a small alphabet.
+ */
+static void Sim_Fill(uint8_t *Data, uint32_t Length)
+{
+    uint32_t i = 0;
+
+    for (i = 0; i < Length; i++)
+    {
+        Data[i] = (0u == (Sim_Random() & 0x3u)) ? Sim_Random() : (uint8_t)(Sim_Random() & 0x1Fu);
+    }
+}
+
+/*
+ *@brief Runs the built-in updates.
+ *@returns Number of failures.
+ */
+static uint32_t Sim_Builtin(void)
+{
+    uint32_t failures = 0;
+    uint32_t length = 0;
+    uint32_t i = 0;
+
+    Sim_Fill(active_slot, SIM_IMAGE_SIZE);
+
+    /* A few words changed, as a constant or a call target */
+    memcpy(new_image, active_slot, SIM_IMAGE_SIZE);
+    for (i = 0; i < 16u; i++)
+    {
+        new_image[(i * 12289u) % SIM_IMAGE_SIZE] ^= 0x5Au;
+    }
+    length = Patch_Generate(active_slot, SIM_IMAGE_SIZE, new_image, SIM_IMAGE_SIZE, patch, sizeof(patch));
+    failures += Sim_Update("words changed", SIM_IMAGE_SIZE, SIM_IMAGE_SIZE, length);
+    if (PATCH_DONE == Sim_Apply(SIM_IMAGE_SIZE / 2u, patch, length))
+    {
+        printf("FAIL copy past the end of a shorter base accepted\n");
+        failures++;
+    }
+
+    /* A function grown by 1 KB in the middle, the code after it moved */
+    memcpy(new_image, active_slot, SIM_IMAGE_SIZE / 2u);
+    Sim_Fill(&new_image[SIM_IMAGE_SIZE / 2u], 1024u);
+    memcpy(&new_image[SIM_IMAGE_SIZE / 2u + 1024u], &active_slot[SIM_IMAGE_SIZE / 2u], SIM_IMAGE_SIZE / 2u);
+    length = Patch_Generate(active_slot, SIM_IMAGE_SIZE, new_image, SIM_IMAGE_SIZE + 1024u, patch, sizeof(patch));
+    failures += Sim_Update("code inserted", SIM_IMAGE_SIZE, SIM_IMAGE_SIZE + 1024u, length);
+
+    /* Code removed and blocks reordered */
+    memcpy(new_image, &active_slot[SIM_IMAGE_SIZE / 2u], SIM_IMAGE_SIZE / 4u);
+    memcpy(&new_image[SIM_IMAGE_SIZE / 4u], active_slot, SIM_IMAGE_SIZE / 4u);
+    length = Patch_Generate(active_slot, SIM_IMAGE_SIZE, new_image, SIM_IMAGE_SIZE / 2u, patch, sizeof(patch));
+    failures += Sim_Update("code removed and moved", SIM_IMAGE_SIZE, SIM_IMAGE_SIZE / 2u, length);
+
+    /* Nothing in common */
+    Sim_Fill(new_image, SIM_IMAGE_SIZE);
+    length = Patch_Generate(active_slot, SIM_IMAGE_SIZE, new_image, SIM_IMAGE_SIZE, patch, sizeof(patch));
+    failures += Sim_Update("unrelated image", SIM_IMAGE_SIZE, SIM_IMAGE_SIZE, length);
+
+    return failures;
+}
+
+/*
+ *@brief Reads a whole file.
+ *@returns Length of the file; 0 if it cannot be read or is larger than Size.
+ */
+static uint32_t Sim_Read_File(const char *Path, uint8_t *Data, uint32_t Size)
+{
+    FILE *file = fopen(Path, "rb");
+    uint32_t length = 0;
+
+    if (NULL != file)
+    {
+        length = (uint32_t)fread(Data, 1, Size, file);
+        if (0 == feof(file) && EOF != fgetc(file))
+        {
+            length = 0;
+        }
+        fclose(file);
+    }
+    else
+    {
+        /* Do nothing */
+    }
+
+    return length;
+}
+
+int main(int argc, char **argv)
+{
+    uint32_t failures = 0;
+    uint32_t old_length = 0;
+    uint32_t new_length = 0;
+    uint32_t patch_length = 0;
+
+    if (4 == argc)
+    {
+        old_length = Sim_Read_File(argv[1], active_slot, sizeof(active_slot));
+        new_length = Sim_Read_File(argv[2], new_image, sizeof(new_image));
+        patch_length = Sim_Read_File(argv[3], patch, sizeof(patch));
+        if (0 == old_length || 0 == new_length || 0 == patch_length)
+        {
+            fprintf(stderr, "patch_sim: cannot read the images or the patch\n");
+            failures++;
+        }
+        else
+        {
+            failures += Sim_Update(argv[3], old_length, new_length, patch_length);
+        }
+    }
+    else if (1 == argc)
+    {
+        failures += Sim_Builtin();
+    }
+    else
+    {
+        fprintf(stderr, "usage: patch_sim [<old.bin> <new.bin> <patch.bin>]\n");
+        failures++;
+    }
+    printf("Delta patches: %s\n", (0 == failures) ? "ok" : "FAILED");
+
+    return (0 == failures) ? 0 : 1;
+}
+
+/* EOF */